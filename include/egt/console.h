@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_CONSOLE_H
+#define EGT_CONSOLE_H
+
+/**
+ * @file
+ * @brief Working with a read-only console.
+ */
+
+#include <egt/color.h>
+#include <egt/detail/meta.h>
+#include <egt/detail/ringbuffer.h>
+#include <egt/detail/textdocument.h>
+#include <egt/font.h>
+#include <egt/types.h>
+#include <egt/widget.h>
+#include <memory>
+#include <string>
+
+namespace egt
+{
+inline namespace v1
+{
+class Frame;
+class Painter;
+
+/**
+ * Read-only console for high rate, append-only text like logs.
+ *
+ * Only the last max_lines() lines are kept, in a ring buffer, and each line is
+ * laid out once when it is added.  Lines are not wrapped.
+ *
+ * The visible lines are kept in a backing image.  When new lines scroll the
+ * view, the pixels already drawn are moved up and only the new lines are
+ * drawn, so the cost of drawing does not depend on how many lines are
+ * visible.
+ *
+ * append() can be called from any thread.  Appended lines are queued and
+ * added together on the next run of the event loop, so many appends between
+ * two frames are drawn at once.
+ *
+ * @b Example
+ * @code{.cpp}
+ * Console console(Rect(0, 0, 400, 300));
+ * std::thread([&console]()
+ * {
+ *     for (auto x = 0; x < 10000; ++x)
+ *         console.append("line " + std::to_string(x));
+ * }).detach();
+ * @endcode
+ *
+ * @ingroup controls
+ */
+class EGT_API Console : public Widget
+{
+public:
+
+    /// Default maximum number of lines.
+    static constexpr size_t DEFAULT_MAX_LINES = 1000;
+
+    /**
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] max_lines Maximum number of lines to keep.
+     */
+    explicit Console(const Rect& rect = {},
+                     size_t max_lines = DEFAULT_MAX_LINES) noexcept;
+
+    /**
+     * @param[in] parent The parent Frame.
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] max_lines Maximum number of lines to keep.
+     */
+    explicit Console(Frame& parent, const Rect& rect = {},
+                     size_t max_lines = DEFAULT_MAX_LINES) noexcept;
+
+    Console(const Console&) = delete;
+    Console& operator=(const Console&) = delete;
+    Console(Console&&) = delete;
+    Console& operator=(Console&&) = delete;
+
+    void draw(Painter& painter, const Rect& rect) override;
+
+    /**
+     * Append text.
+     *
+     * The text is split into lines at each line break, and a line break at
+     * the end of the text does not add an empty line.
+     *
+     * This is safe to call from any thread.  The text shows up after the
+     * event loop runs, or after flush() is called.
+     */
+    void append(const std::string& text);
+
+    /**
+     * Add any lines queued by append() now.
+     *
+     * This must be called from the event loop thread.
+     */
+    void flush();
+
+    /**
+     * Remove all lines, including any queued by append().
+     */
+    void clear();
+
+    /**
+     * Set the maximum number of lines to keep.
+     */
+    void max_lines(size_t lines);
+
+    /**
+     * Get the maximum number of lines to keep.
+     */
+    EGT_NODISCARD size_t max_lines() const { return m_lines.capacity(); }
+
+    /**
+     * Get the number of lines.
+     */
+    EGT_NODISCARD size_t line_count() const { return m_lines.size(); }
+
+    /**
+     * Get a line, where 0 is the oldest one kept.
+     */
+    EGT_NODISCARD const std::string& line(size_t index) const { return m_lines[index].text; }
+
+    /**
+     * Enable or disable scrolling to new lines.
+     *
+     * When disabled, the view stays on the same lines while new lines are
+     * added, until they are dropped.
+     */
+    void autoscroll(bool enabled) { m_autoscroll = enabled; }
+
+    /**
+     * Returns true if the view scrolls to new lines.
+     */
+    EGT_NODISCARD bool autoscroll() const { return m_autoscroll; }
+
+    /**
+     * Scroll the view back from the last line.
+     *
+     * @param[in] lines Number of lines between the last line and the last
+     *            visible line.
+     */
+    void scroll_offset(size_t lines);
+
+    /**
+     * Get the number of lines the view is scrolled back from the last line.
+     */
+    EGT_NODISCARD size_t scroll_offset() const { return m_offset; }
+
+    ~Console() noexcept override;
+
+protected:
+
+    /// A laid out line.
+    struct Line
+    {
+        std::string text;
+        detail::TextDocument::LineLayout layout;
+    };
+
+    /// Append queue shared with other threads.
+    struct Pending;
+
+    /// Add lines taken from the append queue.
+    void add(std::vector<std::string>& lines);
+
+    /// Bring the backing image up to date.
+    void update_backing(const Size& size);
+
+    /// Draw a line of the backing image.
+    void draw_line(Painter& painter, size_t seq, int y, float ascent);
+
+    /// Queued lines and the event loop handler that takes them.
+    std::shared_ptr<Pending> m_pending;
+
+    /// Lines kept.
+    detail::RingBuffer<Line> m_lines;
+
+    /// Number of lines ever added, which is one past the newest line.
+    size_t m_total{0};
+
+    /// Lines between the last line and the last visible line.
+    size_t m_offset{0};
+
+    /// Scroll to new lines.
+    bool m_autoscroll{true};
+
+    /// Image of the visible lines.
+    shared_cairo_surface_t m_backing;
+
+    /// Whether m_backing holds the lines ending at m_drawn_end.
+    bool m_backing_valid{false};
+
+    /// One past the last line drawn on m_backing.
+    size_t m_drawn_end{0};
+
+    /// Font the lines are laid out with.
+    Font m_layout_font;
+
+    /// Text color m_backing was drawn with.
+    Color m_drawn_color;
+};
+
+}
+}
+
+#endif
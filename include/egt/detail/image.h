@@ -12,6 +12,7 @@
  */
 
 #include <egt/detail/meta.h>
+#include <egt/geometry.h>
 #include <egt/types.h>
 #include <string>
 
@@ -45,6 +46,45 @@ EGT_API shared_cairo_surface_t load_image_from_filesystem(const std::string& pat
  */
 EGT_API shared_cairo_surface_t load_image_from_network(const std::string& url);
 
+/**
+ * Get the size of an image from its header without decoding it.
+ *
+ * Only formats with a cheap to parse header are supported: PNG, JPEG, BMP and
+ * ERAW.
+ *
+ * @return The size of the image, or an empty size if it can't be determined.
+ */
+EGT_API Size probe_image_size(const unsigned char* data, size_t len);
+
+/**
+ * Get the size of an image from its header without decoding it.
+ *
+ * @param uri Resource path. @see @ref resources
+ * @return The size of the image, or an empty size if it can't be determined.
+ */
+EGT_API Size probe_image_size(const std::string& uri);
+
+/**
+ * Scan a surface to determine if every pixel is fully opaque.
+ *
+ * The result is remembered on the surface, so scanning the same surface again
+ * is free.  This must only be used on surfaces that are not modified later.
+ */
+EGT_API bool scan_opaque(cairo_surface_t* surface);
+
+/**
+ * Get the opaque state remembered by scan_opaque().
+ *
+ * @return false if the surface was never scanned or is not opaque.
+ */
+EGT_API bool is_opaque(cairo_surface_t* surface);
+
+/**
+ * Remember an already known opaque state on a surface, so scan_opaque() does
+ * not have to scan it.
+ */
+EGT_API void mark_opaque(cairo_surface_t* surface, bool opaque);
+
 /**
   * Return the mime type string for a file.
   *
@@ -45,6 +45,37 @@ public:
      */
     void clear();
 
+    /**
+     * Set a directory to persist decoded and scaled images in.
+     *
+     * Images found in this directory are mapped into memory instead of being
+     * decoded again, which mostly helps the first load of images after
+     * startup. An empty path disables it, which is the default unless the
+     * EGT_IMAGE_CACHE_DIR environment variable is set.
+     */
+    void cache_directory(const std::string& dir);
+
+    /**
+     * Get the directory images are persisted in.
+     */
+    EGT_NODISCARD const std::string& cache_directory() const;
+
+    /**
+     * Set the maximum number of bytes images persisted in cache_directory()
+     * may use.
+     *
+     * The images that were not used for the longest time are removed to stay
+     * under the limit.  This defaults to the EGT_IMAGE_CACHE_SIZE environment
+     * variable, or 32 MiB.
+     */
+    void cache_size_limit(size_t bytes);
+
+    /**
+     * Get the maximum number of bytes images persisted in cache_directory()
+     * may use.
+     */
+    EGT_NODISCARD size_t cache_size_limit() const;
+
     static shared_cairo_surface_t scale_surface(const shared_cairo_surface_t& old_surface,
             float old_width, float old_height,
             float new_width, float new_height);
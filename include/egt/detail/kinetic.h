@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_DETAIL_KINETIC_H
+#define EGT_DETAIL_KINETIC_H
+
+#include <array>
+#include <chrono>
+#include <egt/detail/meta.h>
+#include <egt/geometry.h>
+#include <egt/timer.h>
+#include <functional>
+#include <memory>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Kinetic scrolling of an offset.
+ *
+ * While dragging, drag() is given the offset the pointer asks for, and the
+ * time of each one is recorded.  When the pointer is lifted, release()
+ * estimates the velocity from the movement over the last moments of the
+ * drag and starts a fling: the offset keeps moving and slows down with
+ * friction.  If overscroll is allowed, the offset can go past the bounds,
+ * with resistance while dragging, and is pulled back with a spring.
+ *
+ * The fling is stepped once per display frame, and each step is computed
+ * from the time that actually passed, so a slow frame does not slow down
+ * the fling.
+ */
+class EGT_API KineticScroller
+{
+public:
+
+    /// Called with the new offset for each step of a fling.
+    using Callback = std::function<void(const PointF& offset)>;
+
+    /// Interval of fling steps.
+    static constexpr std::chrono::milliseconds FRAME_INTERVAL{16};
+
+    /**
+     * @param[in] callback Called with the new offset for each step of a fling.
+     */
+    explicit KineticScroller(Callback callback = nullptr);
+
+    KineticScroller(const KineticScroller&) = delete;
+    KineticScroller& operator=(const KineticScroller&) = delete;
+    KineticScroller(KineticScroller&&) = delete;
+    KineticScroller& operator=(KineticScroller&&) = delete;
+
+    /**
+     * Set the callback called with the new offset for each step of a fling.
+     */
+    void callback(Callback callback) { m_callback = std::move(callback); }
+
+    /**
+     * Set the range of the offset.
+     */
+    void bounds(const PointF& min, const PointF& max)
+    {
+        m_min = min;
+        m_max = max;
+    }
+
+    /**
+     * Allow the offset to go past the bounds and bounce back.
+     */
+    void overscroll(bool enabled) { m_overscroll = enabled; }
+
+    /**
+     * Start a drag at an offset, stopping any fling.
+     */
+    void begin(const PointF& offset);
+
+    /**
+     * Move the drag.
+     *
+     * @param[in] offset Offset the pointer asks for.
+     * @return The offset to use, which has resistance past the bounds.
+     */
+    PointF drag(const PointF& offset);
+
+    /**
+     * End the drag, and fling if the pointer was moving or the offset is
+     * past the bounds.
+     */
+    void release();
+
+    /**
+     * Stop a fling.
+     */
+    void stop();
+
+    /**
+     * Returns true if a fling is running.
+     */
+    EGT_NODISCARD bool active() const { return m_timer && m_timer->running(); }
+
+    /**
+     * Get the current velocity, in pixels per second.
+     */
+    EGT_NODISCARD PointF velocity() const { return m_velocity; }
+
+protected:
+
+    using clock = std::chrono::steady_clock;
+
+    /// Move one axis for some time, returning true while it is moving.
+    bool step_axis(float& pos, float& velocity, float min, float max, float dt) const;
+
+    /// Step the fling to the current time.
+    void step();
+
+    /// Called with the new offset for each step of a fling.
+    Callback m_callback;
+
+    /// Timer that steps the fling, created by the first fling.
+    std::unique_ptr<PeriodicTimer> m_timer;
+
+    /// A position of the drag, and when it happened.
+    struct Sample
+    {
+        PointF offset;
+        clock::time_point time;
+    };
+
+    /// Last positions of the drag.
+    std::array<Sample, 8> m_samples{};
+
+    /// Number of samples recorded, which may be more than m_samples holds.
+    size_t m_sample_count{0};
+
+    /// Current offset.
+    PointF m_offset;
+
+    /// Current velocity, in pixels per second.
+    PointF m_velocity;
+
+    /// Time of the last step.
+    clock::time_point m_last;
+
+    /// Range of the offset.
+    PointF m_min;
+    PointF m_max;
+
+    /// Allow the offset to go past the bounds.
+    bool m_overscroll{true};
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_DETAIL_RINGBUFFER_H
+#define EGT_DETAIL_RINGBUFFER_H
+
+#include <algorithm>
+#include <egt/detail/meta.h>
+#include <utility>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Fixed capacity FIFO that drops the oldest element when full.
+ *
+ * Elements are stored in a single allocation and slots are reused, so once
+ * the buffer is full, adding an element does not allocate.  Index 0 is the
+ * oldest element.
+ *
+ * This is not thread safe.
+ */
+template<class T>
+class RingBuffer
+{
+public:
+
+    /**
+     * @param[in] capacity Maximum number of elements.
+     */
+    explicit RingBuffer(size_t capacity = 0)
+        : m_data(capacity)
+    {}
+
+    /**
+     * Add an element, dropping the oldest one if full.
+     */
+    void push_back(T value)
+    {
+        if (m_data.empty())
+            return;
+
+        append() = std::move(value);
+    }
+
+    /**
+     * Make room for one more element and return it.
+     *
+     * If full, the oldest element is dropped.  The returned slot may still
+     * hold a previous value, which allows reusing its memory.
+     *
+     * @warning The capacity must not be zero.
+     */
+    T& append()
+    {
+        if (m_size < m_data.size())
+            return m_data[(m_head + m_size++) % m_data.size()];
+
+        auto& slot = m_data[m_head];
+        m_head = (m_head + 1) % m_data.size();
+        return slot;
+    }
+
+    /**
+     * Add elements, dropping the oldest ones if full.
+     *
+     * Only the newest capacity() elements of data are kept, and they are
+     * copied in at most two contiguous blocks.
+     */
+    template<class U>
+    void append(const U* data, size_t count)
+    {
+        if (m_data.empty())
+            return;
+
+        if (count > m_data.size())
+        {
+            data += count - m_data.size();
+            count = m_data.size();
+        }
+
+        const auto room = m_data.size() - m_size;
+        if (count > room)
+            pop_front(count - room);
+
+        const auto tail = (m_head + m_size) % m_data.size();
+        const auto first = std::min(count, m_data.size() - tail);
+        std::copy(data, data + first, m_data.begin() + tail);
+        std::copy(data + first, data + count, m_data.begin());
+        m_size += count;
+    }
+
+    /**
+     * Drop the oldest elements.
+     */
+    void pop_front(size_t count = 1)
+    {
+        count = std::min(count, m_size);
+        if (!count)
+            return;
+        m_head = (m_head + count) % m_data.size();
+        m_size -= count;
+    }
+
+    /// Get an element, where 0 is the oldest.
+    T& operator[](size_t index)
+    {
+        return m_data[(m_head + index) % m_data.size()];
+    }
+
+    /// Get an element, where 0 is the oldest.
+    const T& operator[](size_t index) const
+    {
+        return m_data[(m_head + index) % m_data.size()];
+    }
+
+    /// Get the oldest element.
+    T& front() { return (*this)[0]; }
+
+    /// Get the oldest element.
+    EGT_NODISCARD const T& front() const { return (*this)[0]; }
+
+    /// Get the newest element.
+    T& back() { return (*this)[m_size - 1]; }
+
+    /// Get the newest element.
+    EGT_NODISCARD const T& back() const { return (*this)[m_size - 1]; }
+
+    /// Number of elements.
+    EGT_NODISCARD size_t size() const { return m_size; }
+
+    /// Returns true if there are no elements.
+    EGT_NODISCARD bool empty() const { return !m_size; }
+
+    /// Returns true if adding an element drops the oldest one.
+    EGT_NODISCARD bool full() const { return m_size == m_data.size(); }
+
+    /// Maximum number of elements.
+    EGT_NODISCARD size_t capacity() const { return m_data.size(); }
+
+    /**
+     * Change the maximum number of elements, keeping the newest ones.
+     */
+    void capacity(size_t capacity)
+    {
+        if (capacity == m_data.size())
+            return;
+
+        std::vector<T> data(capacity);
+        const auto keep = std::min(m_size, capacity);
+        for (size_t x = 0; x < keep; ++x)
+            data[x] = std::move((*this)[m_size - keep + x]);
+
+        m_data = std::move(data);
+        m_head = 0;
+        m_size = keep;
+    }
+
+    /**
+     * Remove all elements.
+     *
+     * The memory of the elements is kept for reuse.
+     */
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+
+    /// Element storage.
+    std::vector<T> m_data;
+    /// Index of the oldest element.
+    size_t m_head{0};
+    /// Number of elements.
+    size_t m_size{0};
+};
+
+}
+}
+}
+
+#endif
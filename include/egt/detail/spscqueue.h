@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_DETAIL_SPSCQUEUE_H
+#define EGT_DETAIL_SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <egt/detail/meta.h>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Fixed capacity, lock-free queue from one producer thread to one consumer
+ * thread.
+ *
+ * push() must only be called from one thread, and pop() from one other
+ * thread.  Neither of them blocks or allocates.  When the queue is full,
+ * push() fails instead of overwriting elements the consumer may be reading.
+ */
+template<class T>
+class SpscQueue
+{
+public:
+
+    /**
+     * @param[in] capacity Minimum number of elements, rounded up to a power
+     *            of two.
+     */
+    explicit SpscQueue(size_t capacity)
+        : m_data(round_capacity(capacity)),
+          m_mask(m_data.size() - 1)
+    {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+    SpscQueue(SpscQueue&&) = delete;
+    SpscQueue& operator=(SpscQueue&&) = delete;
+
+    /**
+     * Add an element, from the producer thread.
+     *
+     * @return false if the queue is full, and the element is not added.
+     */
+    bool push(const T& value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_data.size())
+            return false;
+
+        m_data[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Take the oldest elements, from the consumer thread.
+     *
+     * @param[out] out Array the elements are moved to.
+     * @param[in] max Most elements to take.
+     * @return Number of elements taken.
+     */
+    size_t pop(T* out, size_t max)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        const auto count = std::min(max, m_tail.load(std::memory_order_acquire) - head);
+        for (size_t x = 0; x < count; ++x)
+            out[x] = std::move(m_data[(head + x) & m_mask]);
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Number of elements, which may already be different when it returns.
+     */
+    EGT_NODISCARD size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+    /// Maximum number of elements.
+    EGT_NODISCARD size_t capacity() const { return m_data.size(); }
+
+private:
+
+    static size_t round_capacity(size_t capacity)
+    {
+        size_t result = 1;
+        while (result < capacity)
+            result <<= 1;
+        return result;
+    }
+
+    /// Size of a cache line, to keep the indexes apart.
+    static constexpr size_t CACHE_LINE = 64;
+
+    /// Element storage.
+    std::vector<T> m_data;
+    /// Mask of an index into m_data.
+    size_t m_mask;
+    /// Keeps m_head off the cache line of the members above.
+    char m_pad0[CACHE_LINE]{};
+    /// Index of the oldest element, only written by the consumer.
+    std::atomic<size_t> m_head{0};
+    /// Keeps m_tail off the cache line of m_head.
+    char m_pad1[CACHE_LINE - sizeof(std::atomic<size_t>)]{};
+    /// One past the newest element, only written by the producer.
+    std::atomic<size_t> m_tail{0};
+    /// Keeps m_tail off the cache line of what follows.
+    char m_pad2[CACHE_LINE - sizeof(std::atomic<size_t>)]{};
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_DETAIL_TEXTDOCUMENT_H
+#define EGT_DETAIL_TEXTDOCUMENT_H
+
+#include <cairo.h>
+#include <egt/detail/meta.h>
+#include <egt/font.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Editable UTF-8 text for large documents.
+ *
+ * The text is kept in a gap buffer, so inserting or erasing at the cursor
+ * only moves the bytes between the previous and the new edit position,
+ * instead of copying the whole text.  An index of line starts is updated
+ * incrementally on each edit, so mapping between code point positions and
+ * lines does not scan the text.  The shift an edit causes to the lines after
+ * it is kept pending, and only applied as later edits move away from it, so
+ * editing in one place does not touch the start of every following line.
+ *
+ * Each line also caches its own layout, which is only computed again when
+ * that line is edited.
+ *
+ * All positions and lengths are in code points.
+ */
+class EGT_API TextDocument
+{
+public:
+
+    /// Layout of a single line, relative to the start of its baseline.
+    struct LineLayout
+    {
+        /// Glyphs of the line.
+        std::vector<cairo_glyph_t> run;
+        /// Cursor x position before each code point, and after the last one.
+        std::vector<float> x;
+        /// Whether every code point maps to a single glyph, so run is usable.
+        bool indexed{true};
+    };
+
+    TextDocument();
+
+    /**
+     * @param[in] text Initial text.
+     */
+    explicit TextDocument(const std::string& text);
+
+    /**
+     * Replace all of the text.
+     */
+    void assign(const std::string& text);
+
+    /**
+     * Remove all of the text.
+     */
+    void clear();
+
+    /**
+     * Insert text.
+     *
+     * @param[in] pos Position to insert at.
+     * @param[in] str UTF-8 text to insert.
+     */
+    void insert(size_t pos, const std::string& str);
+
+    /**
+     * Erase text.
+     *
+     * @param[in] pos Position of the first code point to erase.
+     * @param[in] len Number of code points to erase.
+     */
+    void erase(size_t pos, size_t len);
+
+    /**
+     * Get a range of the text.
+     */
+    EGT_NODISCARD std::string substr(size_t pos, size_t len) const;
+
+    /**
+     * Get all of the text.
+     *
+     * The text is only put back together into a single string when this is
+     * called after an edit, so avoid it for every change.
+     */
+    EGT_NODISCARD const std::string& str() const;
+
+    /**
+     * Get the length of the text in code points.
+     */
+    EGT_NODISCARD size_t length() const { return m_length; }
+
+    /**
+     * Get the size of the text in bytes.
+     */
+    EGT_NODISCARD size_t size() const { return m_buf.size() - (m_gap_end - m_gap_start); }
+
+    /**
+     * Returns true if there is no text.
+     */
+    EGT_NODISCARD bool empty() const { return !m_length; }
+
+    /**
+     * Get the number of lines.  This is always at least one.
+     */
+    EGT_NODISCARD size_t line_count() const { return m_lines.size(); }
+
+    /**
+     * Get the line a position is on.
+     */
+    EGT_NODISCARD size_t line_at(size_t pos) const;
+
+    /**
+     * Get the position of the first code point of a line.
+     */
+    EGT_NODISCARD size_t line_start(size_t line) const { return line_pos(line); }
+
+    /**
+     * Get the length of a line, without the line break.
+     */
+    EGT_NODISCARD size_t line_length(size_t line) const;
+
+    /**
+     * Get the text of a line, without the line break.
+     */
+    EGT_NODISCARD std::string line(size_t line) const;
+
+    /**
+     * Get the layout of a line, computing it if needed.
+     *
+     * All layouts are dropped if @b font is not the font of the last call.
+     */
+    const LineLayout& layout(size_t line, const Font& font) const;
+
+    /**
+     * Drop cached layouts of all lines except [first, last).
+     */
+    void keep_layouts(size_t first, size_t last) const;
+
+    /**
+     * Lay out a single line of text.
+     *
+     * The vectors of @b layout are reused, so laying out into the same
+     * layout again does not allocate.
+     */
+    static void layout_line(const std::string& text, const Font& font,
+                            LineLayout& layout);
+
+private:
+
+    struct Line
+    {
+        /// Byte offset of the line, without the pending shift.
+        size_t offset{0};
+        /// Code point position of the line, without the pending shift.
+        size_t pos{0};
+        /// Cached layout of the line.
+        mutable std::unique_ptr<LineLayout> layout;
+
+        Line() = default;
+        Line(size_t o, size_t p) noexcept
+            : offset(o), pos(p)
+        {}
+    };
+
+    /// Get the byte at an offset in the text.
+    EGT_NODISCARD char at(size_t offset) const
+    {
+        return offset < m_gap_start ? m_buf[offset] : m_buf[offset + m_gap_end - m_gap_start];
+    }
+
+    /// Get the byte offset of a position.
+    EGT_NODISCARD size_t offset(size_t pos) const;
+
+    /// Get the byte offset of a line.
+    EGT_NODISCARD size_t line_offset(size_t line) const
+    {
+        return m_lines[line].offset + (line >= m_step_line ? m_step_offset : 0);
+    }
+
+    /// Get the code point position of a line.
+    EGT_NODISCARD size_t line_pos(size_t line) const
+    {
+        return m_lines[line].pos + (line >= m_step_line ? m_step_pos : 0);
+    }
+
+    /// Move the start of the pending shift to a line.
+    void move_step(size_t line);
+
+    /// Copy bytes out of the buffer.
+    void copy(size_t offset, size_t len, std::string& out) const;
+
+    /// Move the gap to a byte offset.
+    void move_gap(size_t offset);
+
+    /// Make sure the gap has room for some bytes.
+    void reserve_gap(size_t len);
+
+    /// Text with a gap at [m_gap_start, m_gap_end).
+    std::vector<char> m_buf;
+    size_t m_gap_start{0};
+    size_t m_gap_end{0};
+    /// Length of the text in code points.
+    size_t m_length{0};
+    /// Start of each line.
+    std::vector<Line> m_lines;
+    /**
+     * Lines from m_step_line on are shifted by m_step_offset bytes and
+     * m_step_pos code points, which may wrap around to shift back.
+     */
+    size_t m_step_line{0};
+    size_t m_step_offset{0};
+    size_t m_step_pos{0};
+    /// Lines that may have a cached layout.
+    mutable size_t m_layout_first{0};
+    mutable size_t m_layout_last{0};
+    /// Font of the cached layouts.
+    mutable Font m_layout_font;
+    /// All of the text, when m_str_valid.
+    mutable std::string m_str;
+    mutable bool m_str_valid{true};
+};
+
+}
+}
+}
+
+#endif
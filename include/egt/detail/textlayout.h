@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_DETAIL_TEXTLAYOUT_H
+#define EGT_DETAIL_TEXTLAYOUT_H
+
+#include <egt/detail/layout.h>
+#include <egt/detail/meta.h>
+#include <egt/font.h>
+#include <egt/geometry.h>
+#include <egt/pattern.h>
+#include <egt/widgetflags.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+class Image;
+class Painter;
+
+namespace detail
+{
+
+/**
+ * Cached layout of a block of text.
+ *
+ * Tokenizing, measuring, and running flex_layout() on text is by far the most
+ * expensive part of drawing it.  This holds the result, the position of each
+ * code point relative to the box, and only computes it again when one of the
+ * inputs to the layout changes.  Drawing is then a replay of the cached
+ * positions.
+ *
+ * Positions are relative to the box, so moving the box does not invalidate
+ * the layout.
+ *
+ * The layout is done in two steps.  The text is first measured and split at
+ * the places it may be wrapped, which only depends on the text and the font.
+ * Those break opportunities are kept, so when only the size or alignment
+ * changes, wrapping again does not scan or measure the text.  Buffers are
+ * reused between updates, so an update does not allocate once they are
+ * large enough.
+ */
+class EGT_API TextLayout
+{
+public:
+
+    /**
+     * Update the layout if any of the inputs changed.
+     *
+     * @param[in] size Size of the box to layout the text in.
+     * @param[in] text The text.
+     * @param[in] font Font of the text.
+     * @param[in] multiline Allow line breaks.
+     * @param[in] word_wrap Wrap on words instead of code points.
+     * @param[in] text_align Alignment of the text in the box.
+     * @param[in] justify Justification of the text.
+     * @param[in] image_align Alignment of the image to the text.
+     * @param[in] image_size Size of the image, or empty for no image.
+     * @return true if the layout was computed again.
+     */
+    bool update(const Size& size,
+                const std::string& text,
+                const Font& font,
+                bool multiline,
+                bool word_wrap,
+                const AlignFlags& text_align,
+                Justification justify,
+                const AlignFlags& image_align = {},
+                const Size& image_size = {});
+
+    /**
+     * Draw the text as laid out by the last update().
+     *
+     * @param[in] painter Painter to draw with.
+     * @param[in] origin Origin of the box.
+     * @param[in] text_color Color of the text.
+     * @param[in] image Image to draw, if the layout includes one.
+     * @param[in] draw_cursor Callback to draw the cursor.
+     * @param[in] cursor_pos Position of the cursor in code points.
+     * @param[in] highlight_color Color of the selection.
+     * @param[in] select_start Start of the selection in code points.
+     * @param[in] select_len Length of the selection in code points.
+     */
+    void draw(Painter& painter,
+              const Point& origin,
+              const Pattern& text_color,
+              const Image* image = nullptr,
+              const std::function<void(const Point& offset, size_t height)>& draw_cursor = nullptr,
+              size_t cursor_pos = 0,
+              const Pattern& highlight_color = {},
+              size_t select_start = 0,
+              size_t select_len = 0) const;
+
+    /**
+     * Drop the layout, so the next update() computes it again.
+     */
+    void clear();
+
+    /**
+     * Returns true if there is no layout.
+     */
+    EGT_NODISCARD bool empty() const { return !m_valid; }
+
+    /**
+     * Get the number of laid out code points, including line breaks added
+     * around the image.
+     */
+    EGT_NODISCARD size_t glyph_count() const { return m_glyphs.size(); }
+
+    /**
+     * Get the cell of a laid out code point, relative to the box.
+     */
+    EGT_NODISCARD RectF glyph_cell(size_t index) const { return m_glyphs[index].cell; }
+
+    /**
+     * Get the cursor position before a laid out code point, relative to the
+     * box.
+     */
+    EGT_NODISCARD PointF glyph_cursor(size_t index) const { return m_glyphs[index].cursor; }
+
+    /**
+     * Get the position of the image, relative to the box.
+     */
+    EGT_NODISCARD Point image_point() const { return m_image_point; }
+
+private:
+
+    /// Measure and split the text at break opportunities.
+    void shape();
+
+    /// Place the tokens in the box.
+    void position();
+
+    /// A code point of the text.
+    struct Glyph
+    {
+        /// Byte offset of the code point in the text.
+        uint32_t offset{0};
+        /// Byte length of the code point.
+        uint32_t len{0};
+        /// Cell of the code point, relative to the box.
+        RectF cell;
+        /// Cursor position before this code point, relative to the box.
+        PointF cursor;
+        /// Glyph index of the code point in the font.
+        unsigned long index{0};
+        /// The code point is a line break.
+        bool newline{false};
+    };
+
+    /// A range of code points laid out as one rect.
+    struct Token
+    {
+        enum class Type
+        {
+            /// Code points of the text.
+            text,
+            /// The image.
+            image,
+            /// A line break that is not in the text.
+            line_break,
+        };
+
+        Type type{Type::text};
+        /// First code point of the token in m_shaped.
+        uint32_t first{0};
+        /// Number of code points in the token.
+        uint32_t count{0};
+        /// Width of the token.
+        float width{0};
+        /// The token is a line break.
+        bool newline{false};
+    };
+
+    /// Measured code points of the text, in text order.
+    std::vector<Glyph> m_shaped;
+    /// Break opportunities of the text.
+    std::vector<Token> m_tokens;
+    /// Tokens including the image, in layout order.
+    std::vector<Token> m_order;
+    /// Rects of m_order given to flex_layout().
+    std::vector<LayoutRect> m_rects;
+    /// Position of the image relative to the box.
+    Point m_image_point;
+    /// Whether the layout includes an image.
+    bool m_has_image{false};
+    /// All laid out code points, in order.
+    std::vector<Glyph> m_glyphs;
+    /// Positioned glyphs of all drawn code points, relative to the box.
+    std::vector<cairo_glyph_t> m_run;
+    /// Whether every code point maps to exactly one glyph, so m_run is used.
+    bool m_indexed{false};
+    /// Cursor position after the last code point, relative to the box.
+    Point m_end_cursor;
+    /// Font height.
+    float m_height{0};
+    /// Font descent.
+    float m_descent{0};
+    /// Whether the layout is valid.
+    bool m_valid{false};
+
+    /// @{
+    /// Inputs of the current layout.
+    std::string m_text;
+    Font m_font;
+    Size m_size;
+    bool m_multiline{false};
+    bool m_word_wrap{false};
+    AlignFlags m_text_align;
+    Justification m_justify{Justification::start};
+    AlignFlags m_image_align;
+    Size m_image_size;
+    /// @}
+};
+
+}
+}
+}
+
+#endif
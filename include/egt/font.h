@@ -30,6 +30,12 @@ inline namespace v1
  * be installed on the system in order to use it.  Usually, if the specified
  * font face cannot be found on the system, a similar font face will be
  * selected.
+ *
+ * The face can also be the path or resource URI of a font file, for example
+ * "file:/usr/share/fonts/FreeSans.ttf" or "res:FreeSans.ttf".  A font file is
+ * opened once and shared by all sizes and weights of the font.  To avoid
+ * fontconfig entirely, face names can be mapped to font files with
+ * add_face() or load_manifest().
  */
 class EGT_API Font
 {
@@ -207,6 +213,43 @@ public:
      */
     static void shutdown_fonts();
 
+    /**
+     * Map a face name, weight, and slant to a font file.
+     *
+     * Faces in the manifest are loaded directly with FreeType, without asking
+     * fontconfig.  If a weight or slant of a face is missing, the normal one
+     * is used instead.
+     *
+     * @param[in] face The face name of the font.
+     * @param[in] uri Path or resource URI of the font file.
+     * @param[in] weight The weight of the font.
+     * @param[in] slant The slant of the font.
+     */
+    static void add_face(const std::string& face, const std::string& uri,
+                         Font::Weight weight = Weight::normal,
+                         Font::Slant slant = Slant::normal);
+
+    /**
+     * Load a font manifest file and add_face() each entry in it.
+     *
+     * Each line of the manifest is a face name, weight, slant, and the path or
+     * resource URI of the font file, separated by commas.  Empty lines and
+     * lines starting with '#' are ignored.  Invalid lines, like one with a
+     * misspelled weight, are skipped with a warning.
+     *
+     * @code{.unparsed}
+     * # face, weight, slant, uri
+     * Free Sans, normal, normal, file:/usr/share/fonts/FreeSans.ttf
+     * Free Sans, bold, normal, res:FreeSansBold.ttf
+     * @endcode
+     *
+     * The manifest named by the EGT_FONT_MANIFEST environment variable is
+     * loaded automatically.
+     *
+     * @param[in] uri Path or resource URI of the manifest.
+     */
+    static void load_manifest(const std::string& uri);
+
 protected:
 
     void direct_allocate();
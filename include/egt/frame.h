@@ -232,6 +232,20 @@ public:
         damage(rect);
     }
 
+    /**
+     * Special variation of scroll_damage() that is to be called explicitly by
+     * child widgets.
+     *
+     * @param[in] child The child widget moving what it shows.
+     * @param[in] rect Rectangle to scroll, in the same coordinates as
+     *            damage_from_child().
+     * @param[in] delta Distance to move the pixels.
+     * @return true if the pixels were moved and the uncovered part was
+     *         damaged, or false if nothing was done and @b rect must be
+     *         damaged instead.
+     */
+    bool scroll_damage_from_child(Widget& child, const Rect& rect, const Point& delta);
+
     void draw(Painter& painter, const Rect& rect) override;
 
     /**
@@ -475,6 +489,37 @@ protected:
     /// @private
     void draw_child(Painter& painter, const Rect& crect, Widget* child);
 
+    /**
+     * Scroll pixels already drawn, instead of damaging them.
+     *
+     * When this frame changes what it shows by moving all of it, like when
+     * scrolling, the pixels already drawn to the screen can be moved, and
+     * only the part that is uncovered needs to be drawn again.  This is only
+     * possible when nothing else is drawn on top of @b rect, when the pixels
+     * are drawn straight to the screen instead of to an offscreen buffer of
+     * a parent, and when the background behind this frame is a solid color.
+     *
+     * @param[in] rect Rectangle to scroll, in the same coordinates as
+     *            damage().
+     * @param[in] delta Distance to move the pixels.
+     * @return true if the pixels were moved and the uncovered part was
+     *         damaged, or false if nothing was done and @b rect must be
+     *         damaged instead.
+     */
+    bool scroll_damage(const Rect& rect, const Point& delta);
+
+    /**
+     * Returns true if the pixels of @b rect, which is part of the child
+     * @b child, can be moved on the screen as far as this frame is concerned.
+     */
+    EGT_NODISCARD bool child_scrollable(const Widget& child, const Rect& rect) const;
+
+    /**
+     * Returns true if children are drawn to an offscreen buffer, instead of
+     * straight to the screen.
+     */
+    EGT_NODISCARD virtual bool offscreen_children() const { return false; }
+
     /// Used internally for calling the special child draw function.
     ChildDrawCallback m_special_child_draw_callback;
 
@@ -493,6 +538,8 @@ protected:
 private:
 
     void remove_all_basic();
+
+    bool scroll_damage_up(const Rect& rect, const Point& delta);
 };
 
 }
@@ -31,6 +31,11 @@ inline namespace v1
  * else using the surface.  To force this class to keep its own copy, call
  * the copy() function.
  *
+ * When constructed from a URI, decoding is deferred until the surface is
+ * first needed, for example when the image is drawn, as long as the size of
+ * the image can be read from its header.  Images that are never shown are
+ * then never decoded.  Call prefetch() to decode ahead of time.
+ *
  * @ingroup media
  */
 class EGT_API Image
@@ -140,6 +145,38 @@ public:
         }
     }
 
+    /**
+     * Decode the image now if decoding was deferred.
+     *
+     * This is a hint that the image will be needed soon, for example to warm
+     * the images of the next page from an idle callback.  Other Image
+     * instances with the same URI and scale share the decoded surface.
+     */
+    void prefetch() const
+    {
+        if (m_deferred)
+            decode();
+    }
+
+    /**
+     * Returns true if every pixel of the image is known to be fully opaque.
+     *
+     * This is determined once when the image is loaded, and allows drawing
+     * the image with a plain copy instead of blending.  Images that may have
+     * been modified, after copy(), are never considered opaque.
+     */
+    EGT_NODISCARD bool opaque() const
+    {
+        if (m_deferred)
+            decode();
+        return m_opaque;
+    }
+
+    /**
+     * Returns true if the image has not been decoded yet.
+     */
+    EGT_NODISCARD bool deferred() const { return m_deferred; }
+
     /**
      * Get the horizontal scale value.
      */
@@ -155,6 +192,9 @@ public:
      */
     EGT_NODISCARD Size size() const
     {
+        if (m_deferred)
+            return m_deferred_size;
+
         if (empty())
             return {};
 
@@ -177,6 +217,9 @@ public:
      */
     EGT_NODISCARD bool empty() const
     {
+        if (m_deferred)
+            return false;
+
         return !surface();
     }
 
@@ -187,6 +230,8 @@ public:
     {
         if (m_surface_local.get())
             return m_surface_local;
+        if (m_deferred)
+            decode();
         return m_surface;
     }
 
@@ -241,6 +286,12 @@ public:
 
 protected:
 
+    /// Load the URI now, or defer decoding if the size is known up front.
+    void load_uri(float hscale, float vscale);
+
+    /// Decode a deferred image.
+    void decode() const;
+
     /// If a URI was used, the URI.
     std::string m_uri;
 
@@ -251,7 +302,7 @@ protected:
     float m_vscale{1.0};
 
     /// Shared surface pointer.
-    shared_cairo_surface_t m_surface;
+    mutable shared_cairo_surface_t m_surface;
 
     /// Local surface pointer.
     shared_cairo_surface_t m_surface_local;
@@ -261,6 +312,24 @@ protected:
 
     /// Internal pattern representation.
     mutable shared_cairo_pattern_t m_pattern;
+
+    /// True if every pixel of the surface is fully opaque.
+    mutable bool m_opaque{false};
+
+    /// True if the surface is still to be decoded from m_uri.
+    mutable bool m_deferred{false};
+
+    /// Size of the source image, when read from its header.
+    Size m_source_size;
+
+    /// Size the deferred image will have once decoded.
+    Size m_deferred_size;
+
+    /// Scale a deferred image will be decoded at.
+    float m_deferred_hscale{1.0};
+
+    /// Scale a deferred image will be decoded at.
+    float m_deferred_vscale{1.0};
 };
 
 static_assert(detail::rule_of_5<Image>(), "must fulfill rule of 5");
@@ -8,9 +8,10 @@
 
 /**
  * @file
- * @brief ListBox definition.
+ * @brief ListBox and ListView definitions.
  */
 
+#include <egt/detail/kinetic.h>
 #include <egt/detail/meta.h>
 #include <egt/frame.h>
 #include <egt/label.h>
@@ -18,7 +19,10 @@
 #include <egt/sizer.h>
 #include <egt/string.h>
 #include <egt/view.h>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace egt
 {
@@ -169,6 +173,243 @@ private:
     void add_item_private(const std::shared_ptr<StringItem>& item);
 };
 
+
+/**
+ * List of a large number of rows provided by a data model.
+ *
+ * Unlike ListBox, there is no widget for each row.  The list is given a
+ * number of rows and a callback that fills in a row widget with the data of
+ * a row.  Only enough row widgets to fill the view, plus a few rows above and
+ * below it, are created, and they are reused for other rows as the list is
+ * scrolled.  All rows have the same height, so the position of a row and the
+ * row under a point are computed instead of searched for.
+ *
+ * Only one row may be selected at a time.
+ *
+ * @b Example
+ * @code{.cpp}
+ * ListView list(Rect(0, 0, 200, 400), 50000, [](size_t row, StringItem& item)
+ * {
+ *     item.text("Alarm " + std::to_string(row));
+ * });
+ * @endcode
+ *
+ * @ingroup controls
+ *
+ * @note This interface only supports a vertical Orientation.
+ */
+class EGT_API ListView : public Frame
+{
+public:
+
+    /**
+     * Event signal.
+     * @{
+     */
+    /**
+     * Invoked when the selection changes.
+     */
+    Signal<> on_selected_changed;
+
+    /**
+     * Invoked when a row is selected with the index of the row selected.
+     */
+    Signal<size_t> on_selected;
+    /** @} */
+
+    /**
+     * Fill in a row widget with the data of a row.
+     *
+     * The widget may have been used for another row before, so everything
+     * that differs between rows must be set.
+     */
+    using RowBinder = std::function<void(size_t row, StringItem& item)>;
+
+    /**
+     * Create a row widget.
+     */
+    using RowFactory = std::function<std::shared_ptr<StringItem>()>;
+
+    /// Default height of a row.
+    static constexpr DefaultDim DEFAULT_ROW_HEIGHT = 40;
+
+    /// Number of rows above and below the view that keep a row widget.
+    static constexpr size_t ROW_MARGIN = 2;
+
+    /**
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] count Number of rows.
+     * @param[in] binder Callback to fill in a row widget.
+     */
+    explicit ListView(const Rect& rect = {},
+                      size_t count = 0,
+                      RowBinder binder = nullptr) noexcept;
+
+    /**
+     * @param[in] parent The parent Frame.
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] count Number of rows.
+     * @param[in] binder Callback to fill in a row widget.
+     */
+    explicit ListView(Frame& parent,
+                      const Rect& rect = {},
+                      size_t count = 0,
+                      RowBinder binder = nullptr) noexcept;
+
+    void handle(Event& event) override;
+
+    void resize(const Size& s) override;
+
+    void layout() override;
+
+    void damage_from_child(const Rect& rect) override;
+
+    /**
+     * Set the number of rows.
+     *
+     * The data of the rows in view is requested again.
+     */
+    void row_count(size_t count);
+
+    /**
+     * Get the number of rows.
+     */
+    EGT_NODISCARD size_t row_count() const { return m_count; }
+
+    /**
+     * Set the callback that fills in a row widget.
+     */
+    void row_binder(RowBinder binder);
+
+    /**
+     * Set the callback that creates row widgets.
+     *
+     * By default, a StringItem is created for each row widget.
+     */
+    void row_factory(RowFactory factory);
+
+    /**
+     * Set the height of every row.
+     */
+    void row_height(DefaultDim height);
+
+    /**
+     * Get the height of every row.
+     */
+    EGT_NODISCARD DefaultDim row_height() const { return m_row_height; }
+
+    /**
+     * Request the data of a row again, if it is in view.
+     *
+     * Call this when the data of a row in the model changes.
+     */
+    void row_changed(size_t row);
+
+    /**
+     * Request the data of all rows in view again.
+     */
+    void rows_changed();
+
+    /**
+     * Select a row by index.
+     */
+    void selected(size_t index);
+
+    /**
+     * Get the currently selected row.
+     *
+     * @return The selected index, or -1 if there is no selection.
+     */
+    EGT_NODISCARD ssize_t selected() const { return m_selected; }
+
+    /**
+     * Get the row at a point.
+     *
+     * @param[in] point Point relative to the origin of the widget.
+     * @return The row, or -1 if there is no row at the point.
+     */
+    EGT_NODISCARD ssize_t row_at(const Point& point) const;
+
+    /**
+     * Scroll the list.
+     *
+     * @param[in] offset Distance from the top of the first row to the top
+     *            of the view.
+     */
+    void offset(DefaultDim offset);
+
+    /**
+     * Get the distance from the top of the first row to the top of the view.
+     */
+    EGT_NODISCARD DefaultDim offset() const { return m_offset; }
+
+    /**
+     * Get the maximum offset().
+     */
+    EGT_NODISCARD DefaultDim offset_max() const;
+
+    /**
+     * Scroll the least amount needed to show a whole row.
+     */
+    void scroll_to(size_t row);
+
+    /**
+     * Scroll all the way to the top of the list.
+     */
+    void scroll_top() { offset(0); }
+
+    /**
+     * Scroll all the way to the bottom of the list.
+     */
+    void scroll_bottom() { offset(offset_max()); }
+
+    /**
+     * Get the number of row widgets, which does not depend on row_count().
+     */
+    EGT_NODISCARD size_t pool_size() const { return m_pool.size(); }
+
+protected:
+
+    /// Change the offset without stopping a fling.
+    void update_offset(DefaultDim offset);
+
+    /// Bind and position the row widgets for the rows in and near the view.
+    void update_rows(bool rebind = false);
+
+    /// Callback to fill in a row widget.
+    RowBinder m_binder;
+
+    /// Callback to create a row widget.
+    RowFactory m_factory;
+
+    /// Row widgets, where row r is always on m_pool[r % m_pool.size()].
+    std::vector<std::shared_ptr<StringItem>> m_pool;
+
+    /// Row bound to each row widget, or -1.
+    std::vector<ssize_t> m_pool_row;
+
+    /// Number of rows.
+    size_t m_count{0};
+
+    /// Height of every row.
+    DefaultDim m_row_height{DEFAULT_ROW_HEIGHT};
+
+    /// Distance from the top of the first row to the top of the view.
+    DefaultDim m_offset{0};
+
+    /// Offset when a drag started.
+    DefaultDim m_start_offset{0};
+
+    /// Fling after a drag.
+    detail::KineticScroller m_kinetic;
+
+    /// Selected row, or -1.
+    ssize_t m_selected{-1};
+
+    /// Row widgets are being moved by a scroll, which damages the view itself.
+    bool m_scrolling{false};
+};
+
 }
 }
 
@@ -14,6 +14,8 @@
 #include <egt/detail/meta.h>
 #include <egt/frame.h>
 #include <egt/signal.h>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,6 +64,13 @@ public:
 /**
  * Allows a collection of NotebookTab widgets to be shown one at a time.
  *
+ * Tabs can be added already built with add(), or as a factory with
+ * add_page().  A page added with a factory is only built the first time it
+ * is selected, so a notebook with many pages starts as fast, and uses as
+ * much memory, as the pages that are actually visited.  With a
+ * page_budget(), the pages built by a factory that were not selected for
+ * the longest time are destroyed, and built again when selected.
+ *
  * @ingroup controls
  */
 class EGT_API Notebook : public Frame
@@ -89,10 +98,50 @@ public:
      */
     explicit Notebook(Frame& parent, const Rect& rect = {}) noexcept;
 
+    /**
+     * Build a page.
+     *
+     * A page may be built more than once, so it must get any state that
+     * should survive from the application model, not from a previous page.
+     */
+    using PageFactory = std::function<std::shared_ptr<NotebookTab>()>;
+
     using Frame::add;
 
     void add(const std::shared_ptr<Widget>& widget) override;
 
+    /**
+     * Add a page that is built the first time it is selected.
+     *
+     * If this is the first page, it is selected and built now.
+     *
+     * @param[in] factory Callback to build the page.
+     * @return The index of the page.
+     */
+    size_t add_page(PageFactory factory);
+
+    /**
+     * Set how many pages built by a factory are kept when not selected.
+     *
+     * When more are built, the ones that were not selected for the longest
+     * time are destroyed.  By default, all of them are kept.
+     *
+     * A page is dropped right away, so get() returns nullptr for it, but it
+     * is only removed and destroyed once back in the event loop.  This way a
+     * widget on a page can switch to another page from its own handler.
+     */
+    void page_budget(size_t pages);
+
+    /**
+     * Get how many pages built by a factory are kept when not selected.
+     */
+    EGT_NODISCARD size_t page_budget() const { return m_page_budget; }
+
+    /**
+     * Get the number of pages, built or not.
+     */
+    EGT_NODISCARD size_t page_count() const { return m_cells.size(); }
+
     void remove(Widget* widget) override;
 
     /**
@@ -114,19 +163,43 @@ public:
      * Get a widget at the specified index.
      *
      * @param index The index of the widget.
+     * @return The widget, or nullptr if it is a page that is not built.
      */
     EGT_NODISCARD NotebookTab* get(size_t index) const;
 
 protected:
 
+    /// A page of the notebook.
+    struct Cell
+    {
+        /// The tab, which is empty for a page that is not built.
+        std::weak_ptr<NotebookTab> tab;
+        /// Builds the tab, or nullptr for a tab that was added built.
+        PageFactory factory;
+        /// When the page was last selected, counted in selections.
+        uint64_t used{0};
+    };
+
     /// Type of array of notebook tabs.
-    using CellArray = std::vector<std::weak_ptr<NotebookTab>>;
+    using CellArray = std::vector<Cell>;
+
+    /// Get a tab, building it if needed.
+    std::shared_ptr<NotebookTab> build(size_t index);
+
+    /// Destroy the pages built by a factory that are over the budget.
+    void trim();
 
     /// Array of notebook tabs.
     CellArray m_cells;
 
     /// Currently selected index.
     ssize_t m_selected{-1};
+
+    /// Pages built by a factory that are kept when not selected.
+    size_t m_page_budget{std::numeric_limits<size_t>::max()};
+
+    /// Number of selections so far.
+    uint64_t m_clock{0};
 };
 
 }
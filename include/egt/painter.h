@@ -358,6 +358,15 @@ public:
 
 protected:
 
+    /**
+     * Returns true if the image can be drawn with CAIRO_OPERATOR_SOURCE.
+     *
+     * That is the case for an opaque image drawn with the default operator,
+     * without scaling, at an integer offset, where copying the pixels gives
+     * the same result as blending them.
+     */
+    bool opaque_blit(const Image& image) const;
+
     /**
      * Cairo context.
      */
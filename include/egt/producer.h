@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_PRODUCER_H
+#define EGT_PRODUCER_H
+
+/**
+ * @file
+ * @brief Feeding widgets from other threads.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <egt/detail/meta.h>
+#include <egt/detail/spscqueue.h>
+#include <egt/valuewidget.h>
+#include <memory>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+class StreamChart;
+
+namespace detail
+{
+
+/**
+ * Base of the producers, which takes what was pushed on the event loop.
+ *
+ * The first push after the event loop took everything posts one handler to
+ * it, so however many values are pushed between two frames, they are taken
+ * together once before the next frame is drawn.
+ */
+class EGT_API ProducerBase
+{
+public:
+
+    ProducerBase();
+
+    ProducerBase(const ProducerBase&) = delete;
+    ProducerBase& operator=(const ProducerBase&) = delete;
+    ProducerBase(ProducerBase&&) = delete;
+    ProducerBase& operator=(ProducerBase&&) = delete;
+
+    /**
+     * Get the number of values that were pushed but never shown.
+     */
+    EGT_NODISCARD uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * Take what was pushed now, instead of waiting for the event loop.
+     *
+     * This must be called from the event loop thread.
+     */
+    void flush() { drain(); }
+
+    virtual ~ProducerBase() noexcept;
+
+protected:
+
+    /// Post a handler to take what was pushed, unless one is already posted.
+    void schedule();
+
+    /// Take what was pushed, on the event loop thread.
+    virtual void drain() = 0;
+
+    /// Values that were pushed but never shown.
+    std::atomic<uint64_t> m_dropped{0};
+
+    /// State shared with the posted handler.
+    struct Link;
+
+    /// State shared with the posted handler.
+    std::shared_ptr<Link> m_link;
+};
+
+}
+
+/**
+ * Feeds samples to a StreamChart series from another thread.
+ *
+ * push() can be called from one producer thread without locking.  Samples
+ * are queued, and everything queued is appended to the series as one block
+ * on the event loop, once per frame.  If the queue is full, samples are
+ * dropped and counted by dropped().
+ *
+ * The producer must be destroyed on the event loop thread, before the chart.
+ *
+ * @b Example
+ * @code{.cpp}
+ * ChartProducer producer(chart, series);
+ * std::thread([&producer]()
+ * {
+ *     while (true)
+ *         producer.push(read_time(), read_sensor());
+ * }).detach();
+ * @endcode
+ */
+class EGT_API ChartProducer : public detail::ProducerBase
+{
+public:
+
+    /// Default number of samples that can be queued.
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @param[in] chart The chart.
+     * @param[in] series Index of the series.
+     * @param[in] capacity Number of samples that can be queued.
+     */
+    ChartProducer(StreamChart& chart, size_t series,
+                  size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Queue a sample of a series where each sample has an x.
+     *
+     * @return false if the queue is full and the sample was dropped.
+     */
+    bool push(double x, double y);
+
+    /**
+     * Queue a sample of a series with a fixed step of x.
+     *
+     * @return false if the queue is full and the sample was dropped.
+     */
+    bool push(double y);
+
+    ~ChartProducer() noexcept override;
+
+protected:
+
+    void drain() override;
+
+    /// A queued sample.
+    struct Sample
+    {
+        double x;
+        double y;
+    };
+
+    /// The chart.
+    StreamChart& m_chart;
+
+    /// Index of the series.
+    size_t m_series;
+
+    /// Whether the series has a fixed step of x.
+    bool m_uniform;
+
+    /// Queued samples.
+    detail::SpscQueue<Sample> m_queue;
+
+    /// Samples taken from the queue, reused by each drain.
+    std::vector<Sample> m_taken;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+};
+
+/**
+ * Feeds values to a ValueRangeWidget, like a gauge, from another thread.
+ *
+ * push() can be called from one producer thread without locking.  Only the
+ * latest value is shown: it is set on the widget on the event loop, once
+ * per frame, and values replaced by a newer one before that are counted by
+ * dropped().
+ *
+ * The producer must be destroyed on the event loop thread, before the
+ * widget.
+ */
+template<class T>
+class ValueProducer : public detail::ProducerBase
+{
+public:
+
+    /**
+     * @param[in] widget The widget.
+     */
+    explicit ValueProducer(ValueRangeWidget<T>& widget)
+        : m_widget(widget)
+    {}
+
+    /**
+     * Set the latest value.
+     */
+    void push(T value)
+    {
+        m_value.store(value, std::memory_order_relaxed);
+        if (m_pending.exchange(true, std::memory_order_release))
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        else
+            schedule();
+    }
+
+protected:
+
+    void drain() override
+    {
+        if (m_pending.exchange(false, std::memory_order_acquire))
+            m_widget.value(m_value.load(std::memory_order_relaxed));
+    }
+
+    /// The widget.
+    ValueRangeWidget<T>& m_widget;
+
+    /// Latest value.
+    std::atomic<T> m_value{};
+
+    /// Whether m_value was not set on the widget yet.
+    std::atomic<bool> m_pending{false};
+};
+
+}
+}
+
+#endif
@@ -14,7 +14,9 @@
 #include <cairo.h>
 #include <cstdint>
 #include <egt/detail/meta.h>
+#include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,6 +33,14 @@ inline namespace v1
  * prefix the name in the URI with scheme 'res' to make EGT read the resource
  * from ResourceManager.
  *
+ * Resources can also come from resource pack files registered with
+ * add_pack().  A pack is mapped into memory and its entries are only looked
+ * up when they are first accessed by name.
+ *
+ * Compressed resources are inflated on first access.  Inflated copies are kept
+ * in a bounded cache, see cache_limit(), and the least recently used copies are
+ * dropped when the limit is exceeded.
+ *
  * @see @ref resources
  */
 class EGT_API ResourceManager
@@ -42,6 +52,12 @@ public:
      */
     static ResourceManager& instance();
 
+    ResourceManager(const ResourceManager&) = delete;
+    ResourceManager& operator=(const ResourceManager&) = delete;
+    ResourceManager(ResourceManager&&) = delete;
+    ResourceManager& operator=(ResourceManager&&) = delete;
+    ~ResourceManager() noexcept;
+
     /**
      * @return true if the resource with the given name is registered.
      */
@@ -59,13 +75,60 @@ public:
      */
     void add(const char* name, const std::vector<unsigned char>& data);
 
+    /**
+     * Register all resources in a resource pack file.
+     *
+     * The file is mapped into memory, not read, and entries are resolved by
+     * name the first time they are accessed.  Resources added with add() take
+     * precedence over pack entries with the same name, and earlier packs take
+     * precedence over later ones.
+     *
+     * @param[in] path Path to the resource pack file.
+     * @throws std::runtime_error if the file cannot be opened or is not a
+     *         valid resource pack.
+     *
+     * @see tools/respack for creating resource packs.
+     */
+    void add_pack(const std::string& path);
+
+    /**
+     * Set the maximum number of bytes used for inflated copies of compressed
+     * resources.
+     *
+     * Inflated copies over the new limit are dropped right away.  After
+     * that, a resource that is inflated is always kept, even if it alone
+     * exceeds the limit.
+     */
+    void cache_limit(size_t bytes);
+
+    /**
+     * Get the maximum number of bytes used for inflated copies of compressed
+     * resources.
+     */
+    EGT_NODISCARD size_t cache_limit() const { return m_cache_limit; }
+
+    /**
+     * Get the number of bytes currently used for inflated copies of
+     * compressed resources.
+     */
+    EGT_NODISCARD size_t cache_size() const { return m_cache_size; }
+
+    /**
+     * Drop all inflated copies of compressed resources.
+     *
+     * They will be inflated again the next time they are accessed.
+     */
+    void evict();
+
     /**
      * Unregister a resource.
+     *
+     * Entries of a resource pack cannot be unregistered individually.
      */
     void remove(const char* name);
 
     /**
-     * Clear all registered resources.
+     * Clear all registered resources, including resource packs.
      */
     void clear();
 
@@ -81,9 +144,38 @@ public:
 
     /**
      * Get a pointer to the in-memory resource data.
+     *
+     * For a resource that is not compressed, the pointer stays valid as long
+     * as the resource is registered.
+     *
+     * @warning For a compressed resource this points into the inflate cache.
+     * Accessing another compressed resource, cache_limit(), evict(), clear()
+     * or remove() may drop it, so the pointer must be used right away.  To
+     * hold on to the data, copy it with read(), or check compressed() first.
      */
     const unsigned char* data(const char* name);
 
+    /**
+     * Get a pointer to the data of a resource as it is stored.
+     *
+     * For a compressed resource this is the compressed data.  Unlike data(),
+     * this never inflates anything, and the pointer stays valid as long as
+     * the resource is registered.
+     *
+     * @param[in] name Name of the resource.
+     * @param[out] len Length of the stored data.
+     * @return The data, or nullptr if the resource is not registered.
+     */
+    const unsigned char* stored_data(const char* name, size_t& len);
+
+    /**
+     * Returns true if the resource is stored compressed.
+     *
+     * The data() of a compressed resource can be evicted, so anything that
+     * holds on to it, instead of reading it right away, must make a copy.
+     */
+    bool compressed(const char* name);
+
     /**
      * Read data from a resource.
      */
@@ -115,10 +207,32 @@ private:
     ResourceManager();
 
     struct ResourceItem;
+    struct Pack;
 
     using ResourceMap = std::map<std::string, ResourceItem>;
 
+    /// Find a registered resource, resolving it from a pack if needed.
+    ResourceItem* find(const char* name);
+
+    /// Make sure the item data is available, inflating it if needed.
+    void resolve(ResourceItem& item);
+
+    /// Drop least recently used inflated copies, except keep.
+    void trim(const ResourceItem* keep);
+
+    /// Remove an item from the inflate cache.
+    void uncache(ResourceItem& item);
+
     ResourceMap m_resources;
+
+    std::vector<std::unique_ptr<Pack>> m_packs;
+
+    /// Inflated items, most recently used first.
+    std::list<ResourceItem*> m_lru;
+
+    size_t m_cache_size{0};
+
+    size_t m_cache_limit{4 * 1024 * 1024};
 };
 
 namespace detail
@@ -55,6 +55,20 @@ public:
      */
     virtual void flip(const DamageArray& damage);
 
+    /**
+     * Move pixels of the composition buffer.
+     *
+     * The pixels in @b rect are moved by @b delta, clipped to @b rect, so
+     * overlapping source and destination are handled.  The moved pixels are
+     * added as damage to the screen buffers, so they are put on the screen
+     * by the next flip(), but nothing is drawn again.  The part of @b rect
+     * that is uncovered is left as is and must be damaged by the caller.
+     *
+     * @return false if the pixel format of the composition buffer is not
+     *         supported, and nothing was done.
+     */
+    bool scroll(const Rect& rect, const Point& delta);
+
     /**
      * Schedule a flip to occur later.
      *
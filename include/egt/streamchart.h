@@ -0,0 +1,510 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_STREAMCHART_H
+#define EGT_STREAMCHART_H
+
+/**
+ * @file
+ * @brief Working with streaming time-series charts.
+ */
+
+#include <cstdint>
+#include <egt/color.h>
+#include <egt/detail/meta.h>
+#include <egt/detail/ringbuffer.h>
+#include <egt/font.h>
+#include <egt/geometry.h>
+#include <egt/types.h>
+#include <egt/widget.h>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+class Frame;
+class Painter;
+
+/**
+ * Line chart for high rate streams of samples, like sensor readings.
+ *
+ * Each series keeps only its newest samples, in a fixed capacity ring
+ * buffer, so appending a sample never allocates.  The chart shows the last
+ * x_span() of x, ending at the newest sample, and scrolls as samples are
+ * appended.
+ *
+ * Samples are decimated to one column per pixel: each column keeps the
+ * first, last, minimum and maximum y of the samples that fall in it, and is
+ * drawn as a vertical line from the minimum to the maximum joined to its
+ * neighbors.  Columns are updated as samples are appended, so drawing costs
+ * the same with 100 or 100000 samples in view, and peaks are never lost.
+ *
+ * When the range of y is fit to the samples, it grows as soon as a sample
+ * falls outside of it, but only shrinks once the samples shown use less than
+ * half of it, so it does not change with every sample.
+ *
+ * In incremental() mode, made for strip charts, the box, grid and labels are
+ * kept in a background image that is only drawn again when the range or
+ * a property of the widget changes, and the lines are kept in a plot image.  As the chart scrolls,
+ * the pixels of the plot image are moved and only the newest columns are
+ * drawn, and only the plot area is damaged.
+ *
+ * Samples can be appended in blocks from contiguous arrays of x and y, or
+ * of y only for a series with a fixed step of x, where x is not stored at
+ * all.  Each series stores its x and y in separate arrays, and y can be
+ * stored as float to halve the memory of large series.
+ *
+ * Unlike LineChart, this does not depend on any plotting library.
+ *
+ * @b Example
+ * @code{.cpp}
+ * StreamChart chart(Rect(0, 0, 400, 200));
+ * chart.x_span(1.0);
+ * auto series = chart.add_series(Palette::red, 10000);
+ * for (auto x = 0; x < 10000; ++x)
+ *     chart.append(series, x / 10000., std::sin(x / 100.));
+ * @endcode
+ *
+ * @ingroup controls
+ */
+class EGT_API StreamChart : public Widget
+{
+public:
+
+    /// Default number of samples kept for each series.
+    static constexpr size_t DEFAULT_CAPACITY = 10000;
+
+    /// Format y of a series is stored in.
+    enum class SampleFormat
+    {
+        float64,
+        float32,
+    };
+
+    /**
+     * @param[in] rect Initial rectangle of the widget.
+     */
+    explicit StreamChart(const Rect& rect = {}) noexcept;
+
+    /**
+     * @param[in] parent The parent Frame.
+     * @param[in] rect Initial rectangle of the widget.
+     */
+    explicit StreamChart(Frame& parent, const Rect& rect = {}) noexcept;
+
+    StreamChart(const StreamChart&) = delete;
+    StreamChart& operator=(const StreamChart&) = delete;
+    StreamChart(StreamChart&&) = delete;
+    StreamChart& operator=(StreamChart&&) = delete;
+
+    void draw(Painter& painter, const Rect& rect) override;
+
+    using Widget::damage;
+
+    /**
+     * Damage the whole chart.
+     *
+     * This is what changing a property of the widget, like the palette,
+     * the border, the padding or the fill flags, does.  Any of them may
+     * change how the chart looks, so the cached images are drawn again.
+     */
+    void damage() override
+    {
+        invalidate_layers();
+        Widget::damage();
+    }
+
+    /**
+     * Add a series where each sample has an x.
+     *
+     * @param[in] color Color of the line.
+     * @param[in] capacity Number of samples to keep.
+     * @param[in] format Format y is stored in.
+     * @return Index of the series.
+     */
+    size_t add_series(const Color& color, size_t capacity = DEFAULT_CAPACITY,
+                      SampleFormat format = SampleFormat::float64);
+
+    /**
+     * Add a series with a fixed step of x between samples.
+     *
+     * Only y is stored, and samples are appended with the append() functions
+     * that only take y.
+     *
+     * @param[in] color Color of the line.
+     * @param[in] x0 X of the first sample.
+     * @param[in] step X between two samples, which must be positive.
+     * @param[in] capacity Number of samples to keep.
+     * @param[in] format Format y is stored in.
+     * @return Index of the series.
+     */
+    size_t add_uniform_series(const Color& color, double x0, double step,
+                              size_t capacity = DEFAULT_CAPACITY,
+                              SampleFormat format = SampleFormat::float64);
+
+    /**
+     * Get the number of series.
+     */
+    EGT_NODISCARD size_t series_count() const { return m_series.size(); }
+
+    /**
+     * Append a sample to a series.
+     *
+     * Samples are expected in increasing x.  A sample older than what is
+     * shown is kept but not drawn until the chart is laid out again.
+     *
+     * @param[in] series Index of the series.
+     * @param[in] x X value, usually a time.
+     * @param[in] y Y value.
+     */
+    void append(size_t series, double x, double y)
+    {
+        append(series, &x, &y, 1);
+    }
+
+    /**
+     * Append samples to a series from arrays of x and y.
+     *
+     * If there are more samples than the series keeps, only the newest ones
+     * are looked at.
+     *
+     * @param[in] series Index of the series, which must not have a fixed step.
+     * @param[in] x Array of x values.
+     * @param[in] y Array of y values.
+     * @param[in] count Number of samples in each array.
+     */
+    void append(size_t series, const double* x, const double* y, size_t count);
+
+    /// @copydoc append(size_t, const double*, const double*, size_t)
+    void append(size_t series, const double* x, const float* y, size_t count);
+
+    /**
+     * Append samples to a series with a fixed step of x from an array of y.
+     *
+     * @param[in] series Index of the series, which must have a fixed step.
+     * @param[in] y Array of y values.
+     * @param[in] count Number of samples.
+     */
+    void append(size_t series, const double* y, size_t count);
+
+    /// @copydoc append(size_t, const double*, size_t)
+    void append(size_t series, const float* y, size_t count);
+
+    /**
+     * Remove all samples of all series.
+     */
+    void clear();
+
+    /**
+     * Get the number of samples kept for a series.
+     */
+    EGT_NODISCARD size_t size(size_t series) const { return m_series[series].size(); }
+
+    /**
+     * Get a sample of a series, where 0 is the oldest one kept.
+     */
+    EGT_NODISCARD std::pair<double, double> sample(size_t series, size_t index) const
+    {
+        const auto& s = m_series[series];
+        return {s.x_at(index), s.y_at(index)};
+    }
+
+    /**
+     * Get the step of x between samples of a series, or 0 if each sample
+     * has an x.
+     */
+    EGT_NODISCARD double x_step(size_t series) const { return m_series[series].step; }
+
+    /**
+     * Set the number of samples kept for a series, keeping the newest ones.
+     */
+    void capacity(size_t series, size_t capacity);
+
+    /**
+     * Get the number of samples kept for a series.
+     */
+    EGT_NODISCARD size_t capacity(size_t series) const { return m_series[series].capacity(); }
+
+    /**
+     * Set the range of x shown, ending at the newest sample.
+     *
+     * @param[in] span Range of x, which must be positive.
+     */
+    void x_span(double span);
+
+    /**
+     * Get the range of x shown.
+     */
+    EGT_NODISCARD double x_span() const { return m_x_span; }
+
+    /**
+     * Set a fixed range of y.
+     */
+    void y_range(double min, double max);
+
+    /**
+     * Fit the range of y to the samples shown.
+     *
+     * This is the default.
+     */
+    void y_auto();
+
+    /**
+     * Returns true if the range of y is fit to the samples shown.
+     */
+    EGT_NODISCARD bool y_auto_range() const { return m_y_auto; }
+
+    /**
+     * Set the width of the lines.
+     */
+    void line_width(float width)
+    {
+        if (detail::change_if_diff<>(m_line_width, width))
+        {
+            m_plot_valid = false;
+            damage();
+        }
+    }
+
+    /**
+     * Get the width of the lines.
+     */
+    EGT_NODISCARD float line_width() const { return m_line_width; }
+
+    /**
+     * Set the number of grid divisions on each axis, or 0 for no grid.
+     */
+    void grid_divisions(size_t divisions)
+    {
+        if (detail::change_if_diff<>(m_grid_divisions, divisions))
+        {
+            m_background_valid = false;
+            damage();
+        }
+    }
+
+    /**
+     * Get the number of grid divisions on each axis.
+     */
+    EGT_NODISCARD size_t grid_divisions() const { return m_grid_divisions; }
+
+    /**
+     * Enable or disable drawing incrementally from cached images.
+     *
+     * This uses memory for an image of the widget and an image of the plot
+     * area, and makes drawing a chart that scrolls much cheaper.
+     */
+    void incremental(bool enabled)
+    {
+        if (detail::change_if_diff<>(m_incremental, enabled))
+        {
+            if (!enabled)
+            {
+                m_background.reset();
+                m_plot.reset();
+            }
+            invalidate_layers();
+            damage();
+        }
+    }
+
+    /**
+     * Returns true if drawing incrementally from cached images.
+     */
+    EGT_NODISCARD bool incremental() const { return m_incremental; }
+
+    /**
+     * Get the area the samples are plotted in.
+     */
+    EGT_NODISCARD Rect plot_area() const;
+
+protected:
+
+    /// Samples of one pixel column.
+    struct Column
+    {
+        /// Column number, which is x divided by the x width of a column.
+        int64_t index{0};
+        float first{0};
+        float last{0};
+        float min{0};
+        float max{0};
+        /// Number of samples, 0 for a column no sample fell in.
+        uint32_t count{0};
+    };
+
+    /// A series of samples and its columns.
+    struct Series
+    {
+        Series(const Color& c, size_t capacity, SampleFormat f, double start, double s)
+            : x(s > 0 ? 0 : capacity),
+              y64(f == SampleFormat::float64 ? capacity : 0),
+              y32(f == SampleFormat::float32 ? capacity : 0),
+              format(f),
+              x0(start),
+              step(s),
+              color(c)
+        {}
+
+        EGT_NODISCARD size_t size() const
+        {
+            return format == SampleFormat::float32 ? y32.size() : y64.size();
+        }
+
+        EGT_NODISCARD size_t capacity() const
+        {
+            return format == SampleFormat::float32 ? y32.capacity() : y64.capacity();
+        }
+
+        EGT_NODISCARD double x_at(size_t index) const
+        {
+            if (step > 0)
+                return x0 + static_cast<double>(total - size() + index) * step;
+            return x[index];
+        }
+
+        EGT_NODISCARD double y_at(size_t index) const
+        {
+            return format == SampleFormat::float32 ? y32[index] : y64[index];
+        }
+
+        /// X of each sample, unless the series has a fixed step.
+        detail::RingBuffer<double> x;
+        /// Y of each sample, in one of these depending on format.
+        detail::RingBuffer<double> y64;
+        detail::RingBuffer<float> y32;
+        SampleFormat format;
+        /// X of the first sample, with a fixed step.
+        double x0;
+        /// X between two samples, or 0 if each sample has an x.
+        double step;
+        /// Number of samples ever appended, which gives x with a fixed step.
+        uint64_t total{0};
+        Color color;
+        /// Consecutive columns, the newest one last.
+        detail::RingBuffer<Column> columns;
+    };
+
+    /// Append samples, where x is nullptr for a series with a fixed step.
+    template<class T>
+    void append_samples(size_t series, const double* x, const T* y, size_t count);
+
+    /// Get the column number of an x value.
+    EGT_NODISCARD int64_t column_index(double x) const;
+
+    /**
+     * Add a sample to the columns of a series.
+     *
+     * @return true if the range of y may have changed.
+     */
+    bool add_column_sample(Series& series, double x, double y);
+
+    /// Rebuild the columns of all series from their samples.
+    void rebuild_columns(DefaultDim width);
+
+    /// Update the range of y shown, returning true if it changed.
+    bool update_y_range();
+
+    /// Get the range of y shown.
+    EGT_NODISCARD std::pair<double, double> y_shown() const
+    {
+        if (m_y_auto)
+            return {m_shown_min, m_shown_max};
+        return {m_y_min, m_y_max};
+    }
+
+    /// Draw the grid and the labels.
+    void draw_axes(Painter& painter, const Rect& plot, double ymin, double ymax);
+
+    /// Draw the columns of a series, starting at column from.
+    void draw_series(Painter& painter, const Rect& plot, const Series& series,
+                     double ymin, double ymax, int64_t from);
+
+    /// Force the cached images to be drawn again.
+    void invalidate_layers()
+    {
+        m_background_valid = false;
+        m_plot_valid = false;
+    }
+
+    /// Bring the background image up to date.
+    void update_background(const Rect& plot, double ymin, double ymax);
+
+    /// Bring the plot image up to date.
+    void update_plot(const Rect& plot, double ymin, double ymax);
+
+    /// Damage what appending samples changed.
+    void damage_plot(bool range_changed);
+
+    /// Series.
+    std::vector<Series> m_series;
+
+    /// Range of x shown.
+    double m_x_span{10.0};
+
+    /// Fixed range of y.
+    double m_y_min{0.0};
+    double m_y_max{1.0};
+
+    /// Fit the range of y to the samples shown.
+    bool m_y_auto{true};
+
+    /// Width of the lines.
+    float m_line_width{1.0f};
+
+    /// Number of grid divisions on each axis.
+    size_t m_grid_divisions{4};
+
+    /// Plot width the columns were built for, or 0 if they are not built.
+    DefaultDim m_columns_width{0};
+
+    /// Newest column of all series.
+    int64_t m_last_column{0};
+
+    /// Whether any column exists, which makes m_last_column valid.
+    bool m_has_columns{false};
+
+    /// Range of y shown when fit to the samples.
+    double m_shown_min{0.0};
+    double m_shown_max{1.0};
+
+    /// Draw incrementally from cached images.
+    bool m_incremental{false};
+
+    /// Image of the box, grid and labels.
+    shared_cairo_surface_t m_background;
+
+    /// Whether m_background is up to date.
+    bool m_background_valid{false};
+
+    /// Font m_background was drawn with.
+    Font m_background_font;
+
+    /// Image of the lines in the plot area.
+    shared_cairo_surface_t m_plot;
+
+    /// Whether m_plot holds the columns up to m_drawn_column.
+    bool m_plot_valid{false};
+
+    /// Range of y the images were drawn with.
+    std::pair<double, double> m_plot_range;
+
+    /// Newest column drawn on m_plot.
+    int64_t m_drawn_column{0};
+
+    /// Oldest column changed since m_plot was drawn.
+    int64_t m_dirty_column{std::numeric_limits<int64_t>::max()};
+
+    /// Plot area of the last draw.
+    Rect m_plot_area;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_TABLE_H
+#define EGT_TABLE_H
+
+/**
+ * @file
+ * @brief TableView definition.
+ */
+
+#include <egt/detail/kinetic.h>
+#include <egt/detail/meta.h>
+#include <egt/geometry.h>
+#include <egt/signal.h>
+#include <egt/widget.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+class Frame;
+class Painter;
+
+/**
+ * Table for large data sets, with rows of the same height and a header row.
+ *
+ * There is no widget for each cell: the cells are drawn directly, and only
+ * the cells in the damaged part of the view are drawn.  The data comes from
+ * a cell renderer callback, or a cell text callback for plain text, that is
+ * called for a cell each time it is drawn.  This means a table with a
+ * million rows and dozens of columns costs the same to draw and hold in
+ * memory as one with a screenful of cells.
+ *
+ * The left edge of each column is cached, so finding the columns in view
+ * does not add up column widths.  The header row stays at the top while the
+ * rows scroll, and scrolls sideways with them.
+ *
+ * @b Example
+ * @code{.cpp}
+ * TableView table(Rect(0, 0, 400, 300), 10000, 3);
+ * table.column_title(0, "Step");
+ * table.cell_text([](size_t row, size_t column)
+ * {
+ *     return std::to_string(row * column);
+ * });
+ * @endcode
+ *
+ * @ingroup controls
+ */
+class EGT_API TableView : public Widget
+{
+public:
+
+    /**
+     * Event signal.
+     * @{
+     */
+    /**
+     * Invoked when the selection changes.
+     */
+    Signal<> on_selected_changed;
+
+    /**
+     * Invoked when a row is selected with the index of the row selected.
+     */
+    Signal<size_t> on_selected;
+    /** @} */
+
+    /**
+     * Draw a cell.
+     *
+     * The painter is clipped to the cell, and the font and text color are
+     * set.
+     */
+    using CellRenderer = std::function<void(Painter& painter, const Rect& cell,
+                                            size_t row, size_t column)>;
+
+    /**
+     * Get the text of a cell.
+     */
+    using CellText = std::function<std::string(size_t row, size_t column)>;
+
+    /// Default height of a row.
+    static constexpr DefaultDim DEFAULT_ROW_HEIGHT = 30;
+
+    /// Default width of a column.
+    static constexpr DefaultDim DEFAULT_COLUMN_WIDTH = 100;
+
+    /**
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] rows Number of rows.
+     * @param[in] columns Number of columns.
+     */
+    explicit TableView(const Rect& rect = {},
+                       size_t rows = 0,
+                       size_t columns = 0) noexcept;
+
+    /**
+     * @param[in] parent The parent Frame.
+     * @param[in] rect Initial rectangle of the widget.
+     * @param[in] rows Number of rows.
+     * @param[in] columns Number of columns.
+     */
+    explicit TableView(Frame& parent,
+                       const Rect& rect = {},
+                       size_t rows = 0,
+                       size_t columns = 0) noexcept;
+
+    void draw(Painter& painter, const Rect& rect) override;
+
+    void handle(Event& event) override;
+
+    void resize(const Size& s) override;
+
+    /**
+     * Set the number of rows.
+     */
+    void row_count(size_t count);
+
+    /**
+     * Get the number of rows.
+     */
+    EGT_NODISCARD size_t row_count() const { return m_rows; }
+
+    /**
+     * Set the number of columns.
+     *
+     * New columns have the default width and no title.
+     */
+    void column_count(size_t count);
+
+    /**
+     * Get the number of columns.
+     */
+    EGT_NODISCARD size_t column_count() const { return m_columns.size(); }
+
+    /**
+     * Set the width of a column.
+     *
+     * Nothing is done if there is no such column.
+     */
+    void column_width(size_t column, DefaultDim width);
+
+    /**
+     * Get the width of a column, or 0 if there is no such column.
+     */
+    EGT_NODISCARD DefaultDim column_width(size_t column) const;
+
+    /**
+     * Set the title of a column, shown in the header row.
+     *
+     * Nothing is done if there is no such column.
+     */
+    void column_title(size_t column, const std::string& title);
+
+    /**
+     * Get the title of a column, or an empty string if there is no such
+     * column.
+     */
+    EGT_NODISCARD const std::string& column_title(size_t column) const;
+
+    /**
+     * Set the height of every row, including the header row.
+     */
+    void row_height(DefaultDim height);
+
+    /**
+     * Get the height of every row.
+     */
+    EGT_NODISCARD DefaultDim row_height() const { return m_row_height; }
+
+    /**
+     * Show or hide the header row.
+     */
+    void header(bool enabled);
+
+    /**
+     * Returns true if the header row is shown.
+     */
+    EGT_NODISCARD bool header() const { return m_header; }
+
+    /**
+     * Set the callback that draws a cell.
+     *
+     * This takes precedence over cell_text().
+     */
+    void cell_renderer(CellRenderer renderer);
+
+    /**
+     * Set the callback that gets the text of a cell.
+     */
+    void cell_text(CellText text);
+
+    /**
+     * Draw a cell again, if it is in view.
+     *
+     * Call this when the data of a cell in the model changes.
+     */
+    void cell_changed(size_t row, size_t column);
+
+    /**
+     * Draw all cells in view again.
+     */
+    void cells_changed() { damage(); }
+
+    /**
+     * Select a row by index.
+     */
+    void selected(size_t row);
+
+    /**
+     * Get the currently selected row.
+     *
+     * @return The selected index, or -1 if there is no selection.
+     */
+    EGT_NODISCARD ssize_t selected() const { return m_selected; }
+
+    /**
+     * Get the cell at a point.
+     *
+     * @param[in] point Point relative to the origin of the widget.
+     * @return The row and column, each -1 if there is no cell at the point.
+     *         The row is -1 on the header row.
+     */
+    EGT_NODISCARD std::pair<ssize_t, ssize_t> cell_at(const Point& point) const;
+
+    /**
+     * Get the rectangle of a cell, relative to the origin of the widget.
+     *
+     * The cell may be partly or not at all in view.  An empty rectangle is
+     * returned if there is no such column.
+     */
+    EGT_NODISCARD Rect cell_rect(size_t row, size_t column) const;
+
+    /**
+     * Scroll the table.
+     *
+     * @param[in] offset Distance from the top left of the first cell to the
+     *            top left of the view.
+     */
+    void offset(const Point& offset);
+
+    /**
+     * Get the distance from the top left of the first cell to the top left
+     * of the view.
+     */
+    EGT_NODISCARD Point offset() const { return m_offset; }
+
+    /**
+     * Get the maximum offset().
+     */
+    EGT_NODISCARD Point offset_max() const;
+
+    /**
+     * Scroll the least amount needed to show a whole row.
+     */
+    void scroll_to(size_t row);
+
+protected:
+
+    /// A column.
+    struct Column
+    {
+        std::string title;
+        DefaultDim width{DEFAULT_COLUMN_WIDTH};
+    };
+
+    /// Change the offset without stopping a fling.
+    void update_offset(const Point& offset);
+
+    /// Get the height of the header row, which is 0 if it is hidden.
+    EGT_NODISCARD DefaultDim header_height() const { return m_header ? m_row_height : 0; }
+
+    /// Get the area the rows are shown in, relative to the parent.
+    EGT_NODISCARD Rect body_area() const;
+
+    /// Bring the left edge of each column up to date.
+    void update_column_x() const;
+
+    /// Get the columns from x0 to x1, in table coordinates.
+    EGT_NODISCARD std::pair<size_t, size_t> column_range(DefaultDim x0, DefaultDim x1) const;
+
+    /// Draw one cell, clipped to its rectangle.
+    void draw_cell(Painter& painter, const Rect& cell, size_t row, size_t column);
+
+    /// Draw text in a cell.
+    void draw_text(Painter& painter, const Rect& cell, const std::string& text);
+
+    /// Number of rows.
+    size_t m_rows{0};
+
+    /// Columns.
+    std::vector<Column> m_columns;
+
+    /// Left edge of each column, plus the right edge of the last one.
+    mutable std::vector<DefaultDim> m_column_x;
+
+    /// Whether m_column_x is up to date.
+    mutable bool m_column_x_valid{false};
+
+    /// Height of every row.
+    DefaultDim m_row_height{DEFAULT_ROW_HEIGHT};
+
+    /// Show the header row.
+    bool m_header{true};
+
+    /// Callback to draw a cell.
+    CellRenderer m_renderer;
+
+    /// Callback to get the text of a cell.
+    CellText m_text;
+
+    /// Distance from the top left of the first cell to the top left of the view.
+    Point m_offset;
+
+    /// Offset when a drag started.
+    Point m_start_offset;
+
+    /// Fling after a drag.
+    detail::KineticScroller m_kinetic;
+
+    /// Selected row, or -1.
+    ssize_t m_selected{-1};
+};
+
+}
+}
+
+#endif
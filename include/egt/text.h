@@ -12,6 +12,7 @@
  */
 
 #include <egt/detail/meta.h>
+#include <egt/detail/textdocument.h>
 #include <egt/flags.h>
 #include <egt/font.h>
 #include <egt/image.h>
@@ -34,6 +35,7 @@ inline namespace v1
  * - Cursor movement
  * - Selection Copy/Delete
  * - Multi-line
+ * - Large documents, see TextFlag::large_document
  *
  * @b Example
  * @code{.cpp}
@@ -64,6 +66,20 @@ public:
 
         /// Do not display a virtual keyboard when focus is gained.
         no_virt_keyboard = detail::bit(3),
+
+        /**
+         * Edit the text as a large document.
+         *
+         * The text is kept in a detail::TextDocument instead of a single
+         * string, each line is laid out on its own and only again when it is
+         * edited, and only the visible lines are drawn.  The view scrolls to
+         * keep the cursor visible.  Lines are not wrapped, the text is always
+         * aligned to the top left, and line breaks are always allowed.
+         *
+         * Calling text() on a large document puts the whole text back
+         * together, so avoid doing it on every change.
+         */
+        large_document = detail::bit(4),
     };
 
     /// Text flags.
@@ -142,10 +158,12 @@ public:
 
     void draw(Painter& painter, const Rect& rect) override;
 
-    using TextWidget::text;
-
     void text(const std::string& str) override;
 
+    EGT_NODISCARD const std::string& text() const override;
+
+    EGT_NODISCARD size_t len() const override;
+
     void clear() override;
 
     using TextWidget::min_size_hint;
@@ -357,6 +375,13 @@ private:
     /// Callback for the cursor timeout.
     void cursor_timeout();
 
+    /// Switch between the string and the document, as the flags require.
+    void text_flags_changed();
+
+    /// Draw only the visible lines of the document.
+    void draw_document(Painter& painter,
+                       const std::function<void(const Point& offset, size_t height)>& draw_cursor);
+
     /// The current visible state of the cursor.
     bool m_cursor_state{false};
 
@@ -371,6 +396,15 @@ private:
 
     /// Lost focus registration.
     Signal<>::RegisterHandle m_lost_focus_reg{};
+
+    /// The text, when TextFlag::large_document is set.
+    std::unique_ptr<detail::TextDocument> m_document;
+
+    /// First visible line of the document.
+    size_t m_first_line{0};
+
+    /// Horizontal scroll offset of the document.
+    float m_scroll_x{0};
 };
 
 namespace detail
@@ -406,6 +440,45 @@ EGT_API void draw_text(Painter& painter,
                        const Pattern& highlight_color = {},
                        size_t select_start = 0,
                        size_t select_len = 0);
+
+/**
+ * Internal draw text function using a cached layout.
+ *
+ * The layout is only computed again if the text, font, size of the box, or
+ * any of the flags changed since the last call with the same @b layout.
+ */
+EGT_API void draw_text(TextLayout& layout,
+                       Painter& painter,
+                       const Rect& b,
+                       const std::string& text,
+                       const Font& font,
+                       const TextBox::TextFlags& flags,
+                       const AlignFlags& text_align,
+                       Justification justify,
+                       const Pattern& text_color,
+                       const std::function<void(const Point& offset, size_t height)>& draw_cursor = nullptr,
+                       size_t cursor_pos = 0,
+                       const Pattern& highlight_color = {},
+                       size_t select_start = 0,
+                       size_t select_len = 0);
+
+/// Internal draw text function with associated image using a cached layout.
+EGT_API void draw_text(TextLayout& layout,
+                       Painter& painter,
+                       const Rect& b,
+                       const std::string& text,
+                       const Font& font,
+                       const TextBox::TextFlags& flags,
+                       const AlignFlags& text_align,
+                       Justification justify,
+                       const Pattern& text_color,
+                       const AlignFlags& image_align,
+                       const Image& image,
+                       const std::function<void(const Point& offset, size_t height)>& draw_cursor = nullptr,
+                       size_t cursor_pos = 0,
+                       const Pattern& highlight_color = {},
+                       size_t select_start = 0,
+                       size_t select_len = 0);
 }
 
 }
@@ -12,6 +12,7 @@
  */
 
 #include <egt/detail/meta.h>
+#include <egt/detail/textlayout.h>
 #include <egt/image.h>
 #include <egt/signal.h>
 #include <egt/widget.h>
@@ -96,6 +97,14 @@ public:
      */
     static Font scale_font(const Size& target, const std::string& text, const Font& font);
 
+    /**
+     * Get the cached layout of the text used for drawing.
+     *
+     * The layout is only computed again when the text, font, size, or any
+     * other input to the layout changes.
+     */
+    EGT_NODISCARD detail::TextLayout& text_layout() const { return m_text_layout; }
+
     void serialize(Serializer& serializer) const override;
 
     void deserialize(const std::string& name, const std::string& value,
@@ -111,6 +120,9 @@ protected:
 
     /// The text.
     std::string m_text;
+
+    /// Cached layout of the text.
+    mutable detail::TextLayout m_text_layout;
 };
 
 }
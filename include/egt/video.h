@@ -236,6 +236,27 @@ public:
      */
     EGT_NODISCARD bool has_audio() const;
 
+    /**
+     * Get the number of video frames decoded.
+     *
+     * Frames are not counted when the decoder hands them to a plane by
+     * itself, which is the case for plane windows on the SAMA5D4.
+     */
+    EGT_NODISCARD uint64_t frames_decoded() const;
+
+    /**
+     * Get the number of video frames decoded but never displayed.
+     *
+     * Only the newest frame is kept for the next time the screen is drawn,
+     * so frames are dropped when they are decoded faster than that.
+     */
+    EGT_NODISCARD uint64_t frames_dropped() const;
+
+    /**
+     * Get the number of video frames displayed.
+     */
+    EGT_NODISCARD uint64_t frames_displayed() const;
+
     void serialize(Serializer& serializer) const override;
 
     void deserialize(const std::string& name, const std::string& value,
@@ -12,10 +12,12 @@
  */
 
 #include <egt/canvas.h>
+#include <egt/detail/kinetic.h>
 #include <egt/detail/meta.h>
 #include <egt/frame.h>
 #include <egt/slider.h>
 #include <memory>
+#include <vector>
 
 namespace egt
 {
@@ -31,6 +33,13 @@ inline namespace v1
  * Orientation to see the rest.
  *
  * This is used internally by Widgets, but can also be used directly.
+ *
+ * Children are drawn into a backing store split into square tiles of
+ * TILE_SIZE pixels.  Only the tiles under the view are rendered, a tile is
+ * only rendered again when a child inside it is damaged, and the least
+ * recently used tiles are reused once there are enough of them to cover the
+ * view with a margin.  So the memory used does not depend on how large the
+ * content is.
  */
 class EGT_API ScrolledView : public Frame
 {
@@ -91,15 +100,15 @@ public:
 
     using Frame::damage;
 
-    void damage(const Rect& /*rect*/) override
-    {
-        Frame::damage(box());
-    }
+    /// Size of a tile of the backing store.
+    static constexpr DefaultDim TILE_SIZE = 128;
 
-    void damage_from_child(const Rect& rect) override
-    {
-        damage(rect + m_offset);
-    }
+    /**
+     * Damage the whole view, including all rendered tiles.
+     */
+    void damage(const Rect& rect) override;
+
+    void damage_from_child(const Rect& rect) override;
 
     /**
      * Get the current offset.
@@ -115,6 +124,23 @@ public:
      */
     void offset(Point offset);
 
+    /**
+     * Enable or disable kinetic scrolling.
+     *
+     * When enabled, the view keeps scrolling and slows down after a drag is
+     * released while moving, and bounces back when dragged past the end.
+     */
+    void kinetic(bool enabled)
+    {
+        m_kinetic_enabled = enabled;
+        m_kinetic.overscroll(enabled);
+    }
+
+    /**
+     * Returns true if kinetic scrolling is enabled.
+     */
+    EGT_NODISCARD bool kinetic() const { return m_kinetic_enabled; }
+
     /**
      * Get the maximum offset currently possible.
      *
@@ -187,6 +213,12 @@ protected:
             m_offset.y(0);
     }
 
+    /// Children are drawn to tiles, not to the screen.
+    EGT_NODISCARD bool offscreen_children() const override { return true; }
+
+    /// Change the offset, possibly past the end.
+    void update_offset(Point offset, bool overscroll);
+
     /// Update properties of the sliders.
     void update_sliders();
 
@@ -220,8 +252,45 @@ protected:
     /// Vertical scrollbar policy
     Policy m_vertical_policy{Policy::as_needed};
 
-    /// @private
-    std::unique_ptr<Canvas> m_canvas;
+    /// A rendered part of the content.
+    struct Tile
+    {
+        /// Column and row of the tile.
+        Point index;
+        /// Rendered pixels of the tile.
+        shared_cairo_surface_t surface;
+        /// The tile must be rendered again before it is used.
+        bool dirty{true};
+        /// When the tile was last used, for dropping the least recently used.
+        uint64_t used{0};
+    };
+
+    /// Get the tile at a column and row, rendering it if needed.
+    Tile& tile(const Point& index, const Rect& content);
+
+    /// Render the children in a tile.
+    void render_tile(Tile& tile, const Rect& content);
+
+    /// Mark tiles that intersect a rectangle of the content as dirty.
+    void invalidate_tiles(const Rect& rect);
+
+    /// Rendered tiles.
+    std::vector<Tile> m_tiles;
+
+    /// Maximum number of tiles kept.
+    size_t m_max_tiles{0};
+
+    /// Counter used to find the least recently used tile.
+    uint64_t m_tile_clock{0};
+
+    /// Size of the content the tiles were rendered for.
+    Size m_content_size;
+
+    /// Fling and bounce after a drag.
+    detail::KineticScroller m_kinetic;
+
+    /// Kinetic scrolling is enabled.
+    bool m_kinetic_enabled{true};
 
     /// Width/height of the slider when shown.
     DefaultDim m_slider_dim{8};
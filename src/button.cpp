@@ -116,7 +116,8 @@ void Button::default_draw(const Button& widget, Painter& painter, const Rect& /*
 {
     widget.draw_box(painter, Palette::ColorId::button_bg, Palette::ColorId::border);
 
-    detail::draw_text(painter,
+    detail::draw_text(widget.text_layout(),
+                      painter,
                       widget.content_area(),
                       widget.text(),
                       widget.font(),
@@ -279,7 +280,8 @@ void ImageButton::default_draw(ImageButton& widget, Painter& painter, const Rect
 
         if (!widget.image().empty())
         {
-            detail::draw_text(painter,
+            detail::draw_text(widget.text_layout(),
+                              painter,
                               widget.content_area(),
                               text,
                               widget.font(),
@@ -292,7 +294,8 @@ void ImageButton::default_draw(ImageButton& widget, Painter& painter, const Rect
         }
         else
         {
-            detail::draw_text(painter,
+            detail::draw_text(widget.text_layout(),
+                              painter,
                               widget.content_area(),
                               text,
                               widget.font(),
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include "detail/glyphatlas.h"
+#include "egt/app.h"
+#include "egt/console.h"
+#include "egt/eventloop.h"
+#include "egt/frame.h"
+#include "egt/painter.h"
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+namespace egt
+{
+inline namespace v1
+{
+
+constexpr size_t Console::DEFAULT_MAX_LINES;
+
+struct Console::Pending
+{
+    std::mutex mutex;
+    /// Lines appended since the last time they were taken.
+    std::vector<std::string> lines;
+    /// Only this many of the newest lines are worth keeping.
+    size_t max_lines{0};
+    /// A handler to take the lines is posted to the event loop.
+    bool posted{false};
+    /// The console, or nullptr once it is destroyed.
+    Console* console{nullptr};
+};
+
+Console::Console(const Rect& rect, size_t max_lines) noexcept
+    : Widget(rect),
+      m_pending(std::make_shared<Pending>()),
+      m_lines(max_lines)
+{
+    name("Console" + std::to_string(m_widgetid));
+
+    border(theme().default_border());
+    fill_flags(Theme::FillFlag::blend);
+    padding(5);
+
+    m_pending->max_lines = max_lines;
+    m_pending->console = this;
+}
+
+Console::Console(Frame& parent, const Rect& rect, size_t max_lines) noexcept
+    : Console(rect, max_lines)
+{
+    parent.add(*this);
+}
+
+void Console::append(const std::string& text)
+{
+    std::lock_guard<std::mutex> lock(m_pending->mutex);
+
+    auto& lines = m_pending->lines;
+    size_t start = 0;
+    do
+    {
+        auto end = text.find('\n', start);
+        if (end == std::string::npos)
+            end = text.size();
+        lines.emplace_back(text, start, end - start);
+        start = end + 1;
+    }
+    while (start < text.size());
+
+    // anything older would be dropped when taken
+    if (lines.size() > 2 * m_pending->max_lines + 64)
+        lines.erase(lines.begin(), lines.end() - m_pending->max_lines);
+
+    if (!m_pending->posted && Application::check_instance())
+    {
+        m_pending->posted = true;
+
+        auto pending = m_pending;
+        asio::post(Application::instance().event().io(), [pending]()
+        {
+            std::vector<std::string> lines;
+            Console* console;
+            {
+                std::lock_guard<std::mutex> lock(pending->mutex);
+                lines.swap(pending->lines);
+                pending->posted = false;
+                console = pending->console;
+            }
+
+            if (console)
+                console->add(lines);
+        });
+    }
+}
+
+void Console::flush()
+{
+    std::vector<std::string> lines;
+    {
+        std::lock_guard<std::mutex> lock(m_pending->mutex);
+        lines.swap(m_pending->lines);
+    }
+
+    add(lines);
+}
+
+/// Distance between lines, in whole pixels so moving lines is exact.
+static int line_pitch(const Font& font)
+{
+    const auto& fe = detail::FontMetrics::get(font.scaled_font()).font_extents();
+    return std::max(1, static_cast<int>(std::ceil(fe.height)));
+}
+
+void Console::add(std::vector<std::string>& lines)
+{
+    if (lines.empty() || !max_lines())
+        return;
+
+    const auto b = content_area();
+    const auto pitch = line_pitch(font());
+    const auto rows = static_cast<size_t>((b.height() + pitch - 1) / pitch);
+    const auto old_end = m_total - m_offset;
+    const auto old_oldest = m_total - m_lines.size();
+
+    const auto count = std::min(lines.size(), max_lines());
+    for (auto i = lines.end() - count; i != lines.end(); ++i)
+    {
+        auto& line = m_lines.append();
+        line.text = std::move(*i);
+        detail::TextDocument::layout_line(line.text, font(), line.layout);
+    }
+
+    // lines that never made it into the ring buffer still count
+    m_total += lines.size();
+
+    // keep showing the same lines
+    if (!m_autoscroll)
+        m_offset = std::min(m_offset + lines.size(), m_lines.size() - 1);
+
+    const auto end = m_total - m_offset;
+    const auto first = end > rows ? end - rows : 0;
+
+    // lines in view that dropped out of the ring buffer have to be erased
+    if (m_total - m_lines.size() > std::max(first, old_oldest))
+    {
+        m_backing_valid = false;
+        damage(b);
+        return;
+    }
+
+    if (end == old_end)
+        return;
+
+    // move the lines already on the screen, and only draw the new ones
+    if (m_backing_valid && m_layout_font == font() && end - old_end < rows &&
+        color(Palette::ColorId::text).type() == Pattern::Type::solid)
+    {
+        const auto dy = static_cast<DefaultDim>(end - old_end) * pitch;
+        if (parent() && parent()->scroll_damage_from_child(*this, to_parent(b), Point(0, -dy)))
+            return;
+    }
+
+    damage(b);
+}
+
+void Console::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pending->mutex);
+        m_pending->lines.clear();
+    }
+
+    m_lines.clear();
+    m_offset = 0;
+    m_backing_valid = false;
+    damage();
+}
+
+void Console::max_lines(size_t lines)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pending->mutex);
+        m_pending->max_lines = lines;
+    }
+
+    m_lines.capacity(lines);
+    if (m_offset && m_offset >= m_lines.size())
+        m_offset = m_lines.empty() ? 0 : m_lines.size() - 1;
+    m_backing_valid = false;
+    damage();
+}
+
+void Console::scroll_offset(size_t lines)
+{
+    if (!m_lines.empty() && lines >= m_lines.size())
+        lines = m_lines.size() - 1;
+
+    if (detail::change_if_diff<>(m_offset, lines))
+        damage();
+}
+
+void Console::draw_line(Painter& painter, size_t seq, int y, float ascent)
+{
+    // seq is the number of the line since the first one ever added
+    const auto oldest = m_total - m_lines.size();
+    if (seq < oldest || seq >= m_total)
+        return;
+
+    const auto& line = m_lines[seq - oldest];
+    if (line.layout.run.empty())
+        return;
+
+    auto cr = painter.context().get();
+    if (line.layout.indexed)
+    {
+        Painter::AutoSaveRestore sr(painter);
+        cairo_translate(cr, 0, y + ascent);
+        if (!detail::GlyphAtlas::show_glyphs(cr, line.layout.run.data(), line.layout.run.size()))
+            cairo_show_glyphs(cr, line.layout.run.data(), line.layout.run.size());
+    }
+    else
+    {
+        cairo_move_to(cr, 0, y + ascent);
+        cairo_show_text(cr, line.text.c_str());
+        cairo_new_path(cr);
+    }
+}
+
+void Console::update_backing(const Size& size)
+{
+    if (!m_backing ||
+        cairo_image_surface_get_width(m_backing.get()) != size.width() ||
+        cairo_image_surface_get_height(m_backing.get()) != size.height())
+    {
+        m_backing = shared_cairo_surface_t(
+                        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size.width(), size.height()),
+                        cairo_surface_destroy);
+        m_backing_valid = false;
+    }
+
+    if (m_layout_font != font())
+    {
+        for (size_t x = 0; x < m_lines.size(); ++x)
+            detail::TextDocument::layout_line(m_lines[x].text, font(), m_lines[x].layout);
+        m_layout_font = font();
+        m_backing_valid = false;
+    }
+
+    // moving pixels only works if every pixel has the same color
+    const auto& pattern = color(Palette::ColorId::text);
+    if (pattern.type() != Pattern::Type::solid)
+        m_backing_valid = false;
+    else if (pattern.solid() != m_drawn_color)
+    {
+        m_drawn_color = pattern.solid();
+        m_backing_valid = false;
+    }
+
+    const auto& fe = detail::FontMetrics::get(font().scaled_font()).font_extents();
+    const auto pitch = line_pitch(font());
+    const auto rows = static_cast<size_t>((size.height() + pitch - 1) / pitch);
+    const auto ascent = static_cast<float>(fe.ascent);
+
+    // the last visible line is at the bottom
+    const auto end = m_total - m_offset;
+    const auto line_y = [&](size_t seq)
+    {
+        return size.height() - static_cast<int>(end - seq) * pitch;
+    };
+
+    Painter painter(shared_cairo_t(cairo_create(m_backing.get()), cairo_destroy));
+    auto cr = painter.context().get();
+
+    size_t first = end > rows ? end - rows : 0;
+    if (m_backing_valid && end >= m_drawn_end && end - m_drawn_end < rows)
+    {
+        const auto count = end - m_drawn_end;
+        if (!count)
+            return;
+
+        // move what is already drawn up, and only draw the new lines
+        const auto dy = static_cast<int>(count) * pitch;
+        cairo_surface_flush(m_backing.get());
+        auto data = cairo_image_surface_get_data(m_backing.get());
+        const auto stride = cairo_image_surface_get_stride(m_backing.get());
+        if (dy < size.height())
+            memmove(data, data + dy * stride, (size.height() - dy) * stride);
+        cairo_surface_mark_dirty(m_backing.get());
+
+        cairo_rectangle(cr, 0, size.height() - dy, size.width(), dy);
+        first = m_drawn_end;
+    }
+    else
+    {
+        cairo_rectangle(cr, 0, 0, size.width(), size.height());
+    }
+
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_fill(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+
+    painter.set(font());
+    painter.set(pattern);
+    for (auto seq = first; seq < end; ++seq)
+        draw_line(painter, seq, line_y(seq), ascent);
+
+    cairo_surface_flush(m_backing.get());
+    m_drawn_end = end;
+    m_backing_valid = true;
+}
+
+void Console::draw(Painter& painter, const Rect&)
+{
+    draw_box(painter, Palette::ColorId::bg, Palette::ColorId::border);
+
+    const auto b = content_area();
+    if (b.empty())
+        return;
+
+    update_backing(b.size());
+
+    Painter::AutoSaveRestore sr(painter);
+    auto cr = painter.context().get();
+    cairo_set_source_surface(cr, m_backing.get(), b.x(), b.y());
+    cairo_rectangle(cr, b.x(), b.y(), b.width(), b.height());
+    cairo_fill(cr);
+}
+
+Console::~Console() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_pending->mutex);
+    m_pending->console = nullptr;
+}
+
+}
+}
@@ -32,6 +32,7 @@ CameraImpl::CameraImpl(CameraWindow& interface, const Rect& rect,
                        const std::string& device)
     : m_interface(interface),
       m_devnode(device),
+      m_mailbox([this](GstSample * sample) { take(sample); }),
       m_rect(rect)
 {
     static constexpr auto plugins =
@@ -258,23 +259,22 @@ GstFlowReturn CameraImpl::on_new_buffer(GstElement* elt, gpointer data)
         else
 #endif
         {
-            if (Application::check_instance())
-            {
-                asio::post(Application::instance().event().io(), [impl, sample]()
-                {
-                    if (impl->m_camerasample)
-                        gst_sample_unref(impl->m_camerasample);
-
-                    impl->m_camerasample = sample;
-                    impl->m_interface.damage();
-                });
-            }
+            impl->m_mailbox.put(sample);
         }
         return GST_FLOW_OK;
     }
     return GST_FLOW_ERROR;
 }
 
+void CameraImpl::take(GstSample* sample)
+{
+    if (m_camerasample)
+        gst_sample_unref(m_camerasample);
+
+    m_camerasample = sample;
+    m_interface.damage();
+}
+
 void CameraImpl::get_camera_device_caps()
 {
     std::tuple<std::string, std::string, std::string,
@@ -440,6 +440,9 @@ CameraImpl::~CameraImpl() noexcept
         m_gmain_thread.join();
         g_main_loop_unref(m_gmain_loop);
     }
+
+    if (m_camerasample)
+        gst_sample_unref(m_camerasample);
 }
 
 std::tuple<std::string, std::string, std::string, std::vector<std::tuple<int, int>>>
@@ -6,6 +6,7 @@
 #ifndef EGT_SRC_DETAIL_CAMERA_GSTCAMERAIMPL_H
 #define EGT_SRC_DETAIL_CAMERA_GSTCAMERAIMPL_H
 
+#include "detail/video/gstsamplemailbox.h"
 #include "egt/camera.h"
 #include <gst/gst.h>
 #include <string>
@@ -46,6 +47,7 @@ protected:
     GstElement* m_pipeline{nullptr};
     GstElement* m_appsink{nullptr};
     GstSample* m_camerasample{nullptr};
+    SampleMailbox m_mailbox;
     Rect m_rect;
     GMainLoop* m_gmain_loop{nullptr};
     std::thread m_gmain_thread;
@@ -55,6 +57,9 @@ protected:
 
     void get_camera_device_caps();
 
+    /// Take the newest sample, on the event loop thread.
+    void take(GstSample* sample);
+
     static GstFlowReturn on_new_buffer(GstElement* elt, gpointer data);
 
     static gboolean bus_callback(GstBus* bus, GstMessage* message, gpointer data);
@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "detail/diskcache.h"
+#include "detail/egtlog.h"
+#include "egt/detail/image.h"
+#include "egt/resource.h"
+#include "egt/respath.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#endif
+
+#if defined(HAVE_MMAP) && !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/*
+ * Cache file layout, native endian since the cache never leaves the device.
+ * The pixel data starts at a fixed offset so it stays aligned when mapped.
+ */
+struct DiskCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t flags;
+    uint32_t reserved[9];
+};
+
+static_assert(sizeof(DiskCacheHeader) == 64, "unexpected DiskCacheHeader size");
+
+static constexpr uint32_t DISK_CACHE_MAGIC = 0x43544745; // "EGTC"
+static constexpr uint32_t DISK_CACHE_VERSION = 1;
+/// The surface is known to be fully opaque.
+static constexpr uint32_t DISK_CACHE_OPAQUE = 1u << 0;
+
+constexpr size_t DiskCache::DEFAULT_SIZE_LIMIT;
+
+uint64_t DiskCache::hash(uint64_t h, const void* data, size_t len)
+{
+    // 64 bit FNV-1a
+    if (!h)
+        h = 14695981039346656037ull;
+    const auto bytes = static_cast<const unsigned char*>(data);
+    for (size_t x = 0; x < len; ++x)
+    {
+        h ^= bytes[x];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t DiskCache::hash(uint64_t h, const std::string& str)
+{
+    return hash(h, str.data(), str.size());
+}
+
+uint64_t DiskCache::source_hash(const std::string& uri)
+{
+    std::string path;
+    const auto type = detail::resolve_path(uri, path);
+
+    switch (type)
+    {
+    case detail::SchemeType::filesystem:
+    {
+        struct stat st {};
+        if (stat(path.c_str(), &st))
+            return 0;
+
+        auto h = hash(0, path);
+        h = hash(h, std::to_string(st.st_size));
+        h = hash(h, std::to_string(st.st_mtime));
+        return h;
+    }
+    case detail::SchemeType::resource:
+    {
+        // the stored bytes, so a compressed resource is not inflated
+        size_t len = 0;
+        const auto data = ResourceManager::instance().stored_data(path.c_str(), len);
+        if (!data)
+            return 0;
+
+        auto h = hash(0, path);
+        h = hash(h, std::to_string(len));
+        h = hash(h, data, len);
+        return h;
+    }
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+void DiskCache::directory(const std::string& dir)
+{
+    m_dir = dir;
+    m_size_valid = false;
+    if (m_dir.empty())
+        return;
+
+    if (m_dir.back() != '/')
+        m_dir += '/';
+
+    struct stat st {};
+    if (stat(m_dir.c_str(), &st) && mkdir(m_dir.c_str(), 0755))
+    {
+        detail::warn("unable to create image cache directory: {}", m_dir);
+        m_dir.clear();
+    }
+}
+
+void DiskCache::size_limit(size_t bytes)
+{
+    m_size_limit = bytes;
+    if (!m_size_valid || m_size > m_size_limit)
+        trim();
+}
+
+size_t DiskCache::size() const
+{
+    if (!m_size_valid)
+        trim();
+    return m_size;
+}
+
+void DiskCache::trim() const
+{
+    if (!enabled())
+        return;
+
+    struct File
+    {
+        std::string path;
+        time_t mtime;
+        size_t size;
+    };
+
+    static const std::string suffix = ".cache";
+
+    std::vector<File> files;
+    size_t total = 0;
+
+    auto dir = ::opendir(m_dir.c_str());
+    if (!dir)
+        return;
+
+    while (auto entry = ::readdir(dir))
+    {
+        const std::string name = entry->d_name;
+        if (name.size() <= suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix))
+            continue;
+
+        struct stat st {};
+        const auto file = m_dir + name;
+        if (stat(file.c_str(), &st) || !S_ISREG(st.st_mode))
+            continue;
+
+        files.push_back({file, st.st_mtime, static_cast<size_t>(st.st_size)});
+        total += files.back().size;
+    }
+    ::closedir(dir);
+
+    m_size = total;
+    m_size_valid = true;
+
+    if (total <= m_size_limit)
+        return;
+
+    // oldest first, a hit on load() touches the file
+    std::sort(files.begin(), files.end(), [](const File & lhs, const File & rhs)
+    {
+        return lhs.mtime < rhs.mtime;
+    });
+
+    for (const auto& file : files)
+    {
+        if (total <= m_size_limit)
+            break;
+
+        if (!std::remove(file.path.c_str()))
+        {
+            total -= file.size;
+            EGTLOG_DEBUG("image disk cache removed {}", file.path);
+        }
+    }
+
+    m_size = total;
+}
+
+std::string DiskCache::path(uint64_t key) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.cache", static_cast<unsigned long long>(key));
+    return m_dir + name;
+}
+
+#if defined(HAVE_MMAP) && !defined(WIN32)
+struct DiskCacheMapping
+{
+    void* addr;
+    size_t len;
+};
+
+static cairo_user_data_key_t mapping_key;
+
+static void unmap_surface(void* data)
+{
+    auto mapping = static_cast<DiskCacheMapping*>(data);
+    ::munmap(mapping->addr, mapping->len);
+    delete mapping;
+}
+#endif
+
+shared_cairo_surface_t DiskCache::load(uint64_t key) const
+{
+    if (!enabled())
+        return nullptr;
+
+    const auto file = path(key);
+
+#if defined(HAVE_MMAP) && !defined(WIN32)
+    const int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat st {};
+    if (::fstat(fd, &st) < 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(DiskCacheHeader))
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const auto len = static_cast<size_t>(st.st_size);
+    // private and writable, pages are only copied if somebody draws on them
+    void* addr = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return nullptr;
+
+    DiskCacheHeader header{};
+    memcpy(&header, addr, sizeof(header));
+#else
+    std::ifstream in(file, std::ios::binary);
+    if (!in)
+        return nullptr;
+
+    DiskCacheHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        return nullptr;
+    const auto len = sizeof(header) + static_cast<size_t>(header.stride) * header.height;
+#endif
+
+    const auto format = static_cast<cairo_format_t>(header.format);
+    if (header.magic != DISK_CACHE_MAGIC ||
+        header.version != DISK_CACHE_VERSION ||
+        static_cast<int>(header.stride) !=
+        cairo_format_stride_for_width(format, header.width) ||
+        len < sizeof(header) + static_cast<size_t>(header.stride) * header.height)
+    {
+#if defined(HAVE_MMAP) && !defined(WIN32)
+        ::munmap(addr, len);
+#endif
+        return nullptr;
+    }
+
+#if defined(HAVE_MMAP) && !defined(WIN32)
+    auto surface = shared_cairo_surface_t(
+                       cairo_image_surface_create_for_data(static_cast<unsigned char*>(addr) + sizeof(header),
+                               format, header.width, header.height, header.stride),
+                       cairo_surface_destroy);
+
+    auto mapping = new DiskCacheMapping{addr, len};
+    if (cairo_surface_status(surface.get()) != CAIRO_STATUS_SUCCESS ||
+        cairo_surface_set_user_data(surface.get(), &mapping_key, mapping,
+                                    unmap_surface) != CAIRO_STATUS_SUCCESS)
+    {
+        unmap_surface(mapping);
+        return nullptr;
+    }
+#else
+    auto surface = shared_cairo_surface_t(
+                       cairo_image_surface_create(format, header.width, header.height),
+                       cairo_surface_destroy);
+    if (cairo_surface_status(surface.get()) != CAIRO_STATUS_SUCCESS ||
+        cairo_image_surface_get_stride(surface.get()) != static_cast<int>(header.stride))
+        return nullptr;
+
+    if (!in.read(reinterpret_cast<char*>(cairo_image_surface_get_data(surface.get())),
+                 static_cast<size_t>(header.stride) * header.height))
+        return nullptr;
+
+    cairo_surface_mark_dirty(surface.get());
+#endif
+
+    // don't touch every mapped page just to find out again
+    detail::mark_opaque(surface.get(), header.flags & DISK_CACHE_OPAQUE);
+
+#ifndef WIN32
+    // the modification time orders files for trim()
+    ::utimensat(AT_FDCWD, file.c_str(), nullptr, 0);
+#endif
+
+    EGTLOG_DEBUG("image disk cache hit {}", file);
+
+    return surface;
+}
+
+void DiskCache::store(uint64_t key, const shared_cairo_surface_t& surface) const
+{
+    if (!enabled() || !surface ||
+        cairo_surface_status(surface.get()) != CAIRO_STATUS_SUCCESS)
+        return;
+
+    cairo_surface_flush(surface.get());
+
+    const auto data = cairo_image_surface_get_data(surface.get());
+    if (!data)
+        return;
+
+    DiskCacheHeader header{};
+    header.magic = DISK_CACHE_MAGIC;
+    header.version = DISK_CACHE_VERSION;
+    header.format = cairo_image_surface_get_format(surface.get());
+    header.width = cairo_image_surface_get_width(surface.get());
+    header.height = cairo_image_surface_get_height(surface.get());
+    header.stride = cairo_image_surface_get_stride(surface.get());
+    if (detail::scan_opaque(surface.get()))
+        header.flags |= DISK_CACHE_OPAQUE;
+
+    const auto file = path(key);
+    // write to a temporary file and rename, so a mapped file never changes
+    const auto tmp = file + ".tmp";
+    const auto len = sizeof(header) + static_cast<size_t>(header.stride) * header.height;
+
+    // a file for the same key is replaced
+    size_t replaced = 0;
+    struct stat st {};
+    if (!stat(file.c_str(), &st))
+        replaced = static_cast<size_t>(st.st_size);
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(data),
+                  static_cast<size_t>(header.stride) * header.height);
+        if (!out)
+        {
+            out.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmp.c_str(), file.c_str()))
+    {
+        std::remove(tmp.c_str());
+        return;
+    }
+
+    // only read the directory again when something has to be removed
+    if (m_size_valid)
+    {
+        m_size = m_size - std::min(replaced, m_size) + len;
+        if (m_size <= m_size_limit)
+            return;
+    }
+
+    trim();
+}
+
+DiskCache& disk_cache()
+{
+    static DiskCache cache;
+    static bool init = false;
+    if (!init)
+    {
+        init = true;
+        const auto dir = std::getenv("EGT_IMAGE_CACHE_DIR");
+        if (dir && strlen(dir))
+            cache.directory(dir);
+
+        const auto size = std::getenv("EGT_IMAGE_CACHE_SIZE");
+        if (size && strlen(size))
+            cache.size_limit(std::strtoull(size, nullptr, 10));
+    }
+    return cache;
+}
+
+}
+}
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_SRC_DETAIL_DISKCACHE_H
+#define EGT_SRC_DETAIL_DISKCACHE_H
+
+#include <cstdint>
+#include <egt/detail/meta.h>
+#include <egt/types.h>
+#include <string>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Persistent cache of decoded image surfaces.
+ *
+ * Surfaces are stored as raw pixel data behind a small header, one file per
+ * key, in a cache directory.  On a hit, the file is mapped into memory and
+ * used as the surface data directly, so nothing is decoded or copied.
+ *
+ * Keys are built from source_hash() of the image URI and whatever else
+ * identifies the rendered result, like the scale or an SVG element id.
+ *
+ * The directory is kept under size_limit() by removing the least recently
+ * used files when a stored surface takes it over the limit.  The size of
+ * the directory is counted once, and then kept up to date as surfaces are
+ * stored, so it is only read again when files have to be removed.
+ */
+class EGT_API DiskCache
+{
+public:
+
+    /// Default size_limit().
+    static constexpr size_t DEFAULT_SIZE_LIMIT = 32 * 1024 * 1024;
+
+    /**
+     * Set the cache directory.  An empty path disables the cache.
+     */
+    void directory(const std::string& dir);
+
+    /**
+     * Get the cache directory.
+     */
+    const std::string& directory() const { return m_dir; }
+
+    /**
+     * Returns true if there is a cache directory.
+     */
+    bool enabled() const { return !m_dir.empty(); }
+
+    /**
+     * Set the maximum number of bytes of cache files in the directory.
+     *
+     * Files that were not used for the longest time are removed until the
+     * directory is under the limit.
+     */
+    void size_limit(size_t bytes);
+
+    /**
+     * Get the maximum number of bytes of cache files in the directory.
+     */
+    size_t size_limit() const { return m_size_limit; }
+
+    /**
+     * Get the number of bytes of cache files in the directory, as counted
+     * when it was last read and kept up to date since.
+     */
+    size_t size() const;
+
+    /**
+     * Map a cached surface.
+     *
+     * @return The surface, or nullptr on a miss.
+     */
+    shared_cairo_surface_t load(uint64_t key) const;
+
+    /**
+     * Write a surface to the cache.
+     */
+    void store(uint64_t key, const shared_cairo_surface_t& surface) const;
+
+    /**
+     * Compute a hash that changes when the source of the URI changes.
+     *
+     * Files are identified by path, size, and modification time, so they are
+     * not read.  Resources are identified by their content as it is stored,
+     * which is hashed in place and never inflated.
+     *
+     * @return The hash, or 0 if the source can't be identified.
+     */
+    static uint64_t source_hash(const std::string& uri);
+
+    /**
+     * Combine a string into a hash.
+     */
+    static uint64_t hash(uint64_t h, const std::string& str);
+
+    /**
+     * Combine bytes into a hash.
+     */
+    static uint64_t hash(uint64_t h, const void* data, size_t len);
+
+private:
+
+    /// Path of the cache file for a key.
+    std::string path(uint64_t key) const;
+
+    /// Count the cache files, and remove the least recently used ones over
+    /// size_limit().
+    void trim() const;
+
+    /// Cache directory.
+    std::string m_dir;
+
+    /// Maximum number of bytes of cache files.
+    size_t m_size_limit{DEFAULT_SIZE_LIMIT};
+
+    /// Number of bytes of cache files, if m_size_valid.
+    mutable size_t m_size{0};
+
+    /// Whether m_size was counted for the directory.
+    mutable bool m_size_valid{false};
+};
+
+/**
+ * Global disk cache instance.
+ *
+ * The directory defaults to the EGT_IMAGE_CACHE_DIR environment variable, and
+ * the size limit to EGT_IMAGE_CACHE_SIZE.
+ */
+EGT_API DiskCache& disk_cache();
+
+}
+}
+}
+
+#endif
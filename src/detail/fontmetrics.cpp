@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include <algorithm>
+#include <iterator>
+#include <utf8.h>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+static cairo_user_data_key_t metrics_key;
+
+FontMetrics& FontMetrics::get(cairo_scaled_font_t* font)
+{
+    // a font that failed to load measures as nothing, like cairo draws it
+    if (!font || cairo_scaled_font_status(font) != CAIRO_STATUS_SUCCESS)
+    {
+        static FontMetrics empty(nullptr);
+        return empty;
+    }
+
+    auto metrics = static_cast<FontMetrics*>(cairo_scaled_font_get_user_data(font, &metrics_key));
+    if (metrics)
+        return *metrics;
+
+    metrics = new FontMetrics(font);
+    const auto destroy = [](void* data)
+    {
+        delete static_cast<FontMetrics*>(data);
+    };
+
+    // only fails when out of memory, in which case this leaks the table
+    cairo_scaled_font_set_user_data(font, &metrics_key, metrics, destroy);
+
+    return *metrics;
+}
+
+FontMetrics::FontMetrics(cairo_scaled_font_t* font)
+    : m_font(font)
+{
+    if (m_font)
+        cairo_scaled_font_extents(m_font, &m_font_extents);
+}
+
+FontMetrics::Glyph FontMetrics::measure(uint32_t cp) const
+{
+    if (!m_font)
+        return {};
+
+    char buf[8] {};
+    try
+    {
+        utf8::append(cp, std::begin(buf));
+    }
+    catch (const utf8::invalid_code_point&)
+    {
+        utf8::append(0xfffd, std::begin(buf));
+    }
+
+    Glyph result;
+    cairo_text_extents_t te{};
+
+    cairo_glyph_t* glyphs = nullptr;
+    int num_glyphs = 0;
+    const auto status = cairo_scaled_font_text_to_glyphs(m_font, 0, 0, buf, -1,
+                        &glyphs, &num_glyphs,
+                        nullptr, nullptr, nullptr);
+    if (status == CAIRO_STATUS_SUCCESS && num_glyphs == 1)
+    {
+        result.index = glyphs[0].index;
+        result.simple = true;
+        cairo_scaled_font_glyph_extents(m_font, glyphs, 1, &te);
+    }
+    else
+    {
+        cairo_scaled_font_text_extents(m_font, buf, &te);
+    }
+    cairo_glyph_free(glyphs);
+
+    result.x_bearing = static_cast<float>(te.x_bearing);
+    result.y_bearing = static_cast<float>(te.y_bearing);
+    result.width = static_cast<float>(te.width);
+    result.height = static_cast<float>(te.height);
+    result.x_advance = static_cast<float>(te.x_advance);
+    return result;
+}
+
+const FontMetrics::Glyph& FontMetrics::glyph(uint32_t cp)
+{
+    if (cp < m_ascii.size())
+    {
+        if (!m_ascii_valid[cp])
+        {
+            m_ascii[cp] = measure(cp);
+            m_ascii_valid[cp] = true;
+        }
+        return m_ascii[cp];
+    }
+
+    auto i = m_glyphs.find(cp);
+    if (i != m_glyphs.end())
+        return i->second;
+
+    return m_glyphs.emplace(cp, measure(cp)).first->second;
+}
+
+cairo_text_extents_t FontMetrics::text_extents(const std::string& text)
+{
+    cairo_text_extents_t result{};
+
+    // union of the ink boxes of all glyphs, like cairo does
+    float min_x = 0;
+    float min_y = 0;
+    float max_x = 0;
+    float max_y = 0;
+    bool ink = false;
+    float x = 0;
+
+    auto pos = text.begin();
+    while (pos != text.end())
+    {
+        uint32_t cp;
+        try
+        {
+            cp = utf8::next(pos, text.end());
+        }
+        catch (const utf8::exception&)
+        {
+            ++pos;
+            cp = 0xfffd;
+        }
+
+        const auto& g = glyph(cp);
+        if (g.width > 0 && g.height > 0)
+        {
+            const auto x1 = x + g.x_bearing;
+            const auto y1 = g.y_bearing;
+            const auto x2 = x1 + g.width;
+            const auto y2 = y1 + g.height;
+            if (!ink)
+            {
+                min_x = x1;
+                min_y = y1;
+                max_x = x2;
+                max_y = y2;
+                ink = true;
+            }
+            else
+            {
+                min_x = std::min(min_x, x1);
+                min_y = std::min(min_y, y1);
+                max_x = std::max(max_x, x2);
+                max_y = std::max(max_y, y2);
+            }
+        }
+        x += g.x_advance;
+    }
+
+    if (ink)
+    {
+        result.x_bearing = min_x;
+        result.y_bearing = min_y;
+        result.width = max_x - min_x;
+        result.height = max_y - min_y;
+    }
+    result.x_advance = x;
+
+    return result;
+}
+
+}
+}
+}
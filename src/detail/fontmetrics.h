@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_SRC_DETAIL_FONTMETRICS_H
+#define EGT_SRC_DETAIL_FONTMETRICS_H
+
+#include <array>
+#include <cairo.h>
+#include <cstdint>
+#include <egt/detail/meta.h>
+#include <string>
+#include <unordered_map>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Lazily filled table of glyph metrics for a scaled font.
+ *
+ * The table is owned by the cairo scaled font it describes, so it lives
+ * exactly as long as the font does in the font cache.  Once a code point has
+ * been measured, measuring text with it only takes a table lookup and no
+ * cairo context is needed at all.
+ */
+class EGT_API FontMetrics
+{
+public:
+
+    /// Metrics of a single code point.
+    struct Glyph
+    {
+        /// Glyph index in the font, only valid if simple is set.
+        unsigned long index{0};
+        /// The code point maps to exactly one glyph.
+        bool simple{false};
+        float x_bearing{0};
+        float y_bearing{0};
+        float width{0};
+        float height{0};
+        float x_advance{0};
+    };
+
+    /**
+     * Get the metrics of a scaled font, created on first use.
+     *
+     * A null font, or a font in an error state, gets a shared table where
+     * everything measures as empty.
+     */
+    static FontMetrics& get(cairo_scaled_font_t* font);
+
+    /**
+     * Get the font extents.
+     */
+    const cairo_font_extents_t& font_extents() const { return m_font_extents; }
+
+    /**
+     * Get the metrics of a code point.
+     */
+    const Glyph& glyph(uint32_t cp);
+
+    /**
+     * Get the extents of a string, the same as cairo_text_extents() returns
+     * for a single line of text.
+     */
+    cairo_text_extents_t text_extents(const std::string& text);
+
+    FontMetrics(const FontMetrics&) = delete;
+    FontMetrics& operator=(const FontMetrics&) = delete;
+
+private:
+
+    explicit FontMetrics(cairo_scaled_font_t* font);
+
+    Glyph measure(uint32_t cp) const;
+
+    /// The font, not referenced because it owns this, or nullptr.
+    cairo_scaled_font_t* m_font;
+    cairo_font_extents_t m_font_extents{};
+    /// ASCII is looked up directly.
+    std::array<Glyph, 128> m_ascii{};
+    std::array<bool, 128> m_ascii_valid{};
+    /// Everything else.
+    std::unordered_map<uint32_t, Glyph> m_glyphs;
+};
+
+}
+}
+}
+
+#endif
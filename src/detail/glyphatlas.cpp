@@ -0,0 +1,356 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/glyphatlas.h"
+#include "egt/geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+constexpr int GlyphAtlas::SUBPIXEL_X;
+constexpr int GlyphAtlas::PAGE_SIZE;
+constexpr size_t GlyphAtlas::MAX_PAGES;
+
+static cairo_user_data_key_t atlas_key;
+
+bool GlyphAtlas::enabled()
+{
+    static const bool value = !std::getenv("EGT_NO_GLYPH_ATLAS") ||
+                              !strlen(std::getenv("EGT_NO_GLYPH_ATLAS"));
+    return value;
+}
+
+GlyphAtlas& GlyphAtlas::get(cairo_scaled_font_t* font)
+{
+    auto atlas = static_cast<GlyphAtlas*>(cairo_scaled_font_get_user_data(font, &atlas_key));
+    if (atlas)
+        return *atlas;
+
+    atlas = new GlyphAtlas(font);
+    const auto destroy = [](void* data)
+    {
+        delete static_cast<GlyphAtlas*>(data);
+    };
+
+    // only fails when out of memory, in which case this leaks the atlas
+    cairo_scaled_font_set_user_data(font, &atlas_key, atlas, destroy);
+
+    return *atlas;
+}
+
+size_t GlyphAtlas::page_count(cairo_scaled_font_t* font)
+{
+    return get(font).m_pages.size();
+}
+
+GlyphAtlas::GlyphAtlas(cairo_scaled_font_t* font)
+    : m_font(font)
+{}
+
+bool GlyphAtlas::allocate(int width, int height, Entry& entry)
+{
+    if (width > PAGE_SIZE || height > PAGE_SIZE)
+        return false;
+
+    if (!m_pages.empty())
+    {
+        // next shelf
+        if (m_shelf_x + width > PAGE_SIZE)
+        {
+            m_shelf_x = 0;
+            m_shelf_y += m_shelf_height;
+            m_shelf_height = 0;
+        }
+
+        if (m_shelf_y + height > PAGE_SIZE)
+            m_shelf_x = -1;
+    }
+
+    if (m_pages.empty() || m_shelf_x < 0)
+    {
+        if (m_pages.size() >= MAX_PAGES)
+        {
+            // start over, but anything already looked up must stay valid
+            for (auto& page : m_pages)
+                m_retired.emplace_back(std::move(page));
+            m_pages.clear();
+            m_entries.clear();
+        }
+
+        shared_cairo_surface_t page(cairo_image_surface_create(CAIRO_FORMAT_A8,
+                                    PAGE_SIZE, PAGE_SIZE),
+                                    cairo_surface_destroy);
+        if (cairo_surface_status(page.get()) != CAIRO_STATUS_SUCCESS)
+            return false;
+
+        m_pages.emplace_back(std::move(page));
+        m_shelf_x = 0;
+        m_shelf_y = 0;
+        m_shelf_height = 0;
+    }
+
+    entry.page = m_pages.back().get();
+    entry.x = m_shelf_x;
+    entry.y = m_shelf_y;
+    entry.width = width;
+    entry.height = height;
+
+    m_shelf_x += width;
+    m_shelf_height = std::max(m_shelf_height, height);
+
+    return true;
+}
+
+GlyphAtlas::Entry GlyphAtlas::rasterize(unsigned long index, int subpixel)
+{
+    Entry entry;
+
+    cairo_glyph_t glyph{index, 0, 0};
+    cairo_text_extents_t te;
+    cairo_scaled_font_glyph_extents(m_font, &glyph, 1, &te);
+    if (te.width <= 0 || te.height <= 0)
+        return entry;
+
+    const auto sx = static_cast<double>(subpixel) / SUBPIXEL_X;
+
+    // one pixel of margin for antialiasing
+    const auto x0 = static_cast<int>(std::floor(te.x_bearing + sx)) - 1;
+    const auto y0 = static_cast<int>(std::floor(te.y_bearing)) - 1;
+    const auto x1 = static_cast<int>(std::ceil(te.x_bearing + te.width + sx)) + 1;
+    const auto y1 = static_cast<int>(std::ceil(te.y_bearing + te.height)) + 1;
+
+    if (!allocate(x1 - x0, y1 - y0, entry))
+    {
+        entry.too_big = true;
+        return entry;
+    }
+
+    entry.left = x0;
+    entry.top = y0;
+
+    // fill the outline, so the subpixel offset is honored
+    auto cr = cairo_create(entry.page);
+    cairo_rectangle(cr, entry.x, entry.y, entry.width, entry.height);
+    cairo_clip(cr);
+    cairo_set_scaled_font(cr, m_font);
+    glyph.x = entry.x - x0 + sx;
+    glyph.y = entry.y - y0;
+    cairo_glyph_path(cr, &glyph, 1);
+    cairo_fill(cr);
+    cairo_destroy(cr);
+
+    cairo_surface_flush(entry.page);
+
+    return entry;
+}
+
+const GlyphAtlas::Entry& GlyphAtlas::lookup(unsigned long index, int subpixel)
+{
+    const auto key = (static_cast<uint64_t>(index) << 8) | static_cast<uint64_t>(subpixel);
+    auto i = m_entries.find(key);
+    if (i != m_entries.end())
+        return i->second;
+
+    auto entry = rasterize(index, subpixel);
+    return m_entries.emplace(key, entry).first->second;
+}
+
+static inline uint32_t div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+/*
+ * Blend a row of an A8 mask with a solid premultiplied color, OVER the
+ * destination.  This is the same math pixman uses for OVER with a mask.
+ * There are no branches in the loop, so the compiler can vectorize it.
+ */
+static void blend_row(uint32_t* dst, const uint8_t* mask, int width,
+                      uint32_t ca, uint32_t cr, uint32_t cg, uint32_t cb)
+{
+    for (auto x = 0; x < width; ++x)
+    {
+        const uint32_t m = mask[x];
+        const uint32_t d = dst[x];
+
+        const auto sa = div255(ca * m);
+        const auto inv = 255 - sa;
+
+        const auto a = sa + div255(((d >> 24) & 0xff) * inv);
+        const auto r = div255(cr * m) + div255(((d >> 16) & 0xff) * inv);
+        const auto g = div255(cg * m) + div255(((d >> 8) & 0xff) * inv);
+        const auto b = div255(cb * m) + div255((d & 0xff) * inv);
+
+        dst[x] = (a << 24) | (r << 16) | (g << 8) | b;
+    }
+}
+
+bool GlyphAtlas::show_glyphs(cairo_t* cr, const cairo_glyph_t* glyphs, int num_glyphs)
+{
+    if (!enabled() || num_glyphs <= 0)
+        return false;
+
+    if (cairo_get_operator(cr) != CAIRO_OPERATOR_OVER)
+        return false;
+
+    auto target = cairo_get_group_target(cr);
+    if (cairo_surface_get_type(target) != CAIRO_SURFACE_TYPE_IMAGE)
+        return false;
+
+    const auto format = cairo_image_surface_get_format(target);
+    if (format != CAIRO_FORMAT_ARGB32 && format != CAIRO_FORMAT_RGB24)
+        return false;
+
+    auto source = cairo_get_source(cr);
+    if (cairo_pattern_get_type(source) != CAIRO_PATTERN_TYPE_SOLID)
+        return false;
+
+    double red;
+    double green;
+    double blue;
+    double alpha;
+    cairo_pattern_get_rgba(source, &red, &green, &blue, &alpha);
+
+    cairo_matrix_t matrix;
+    cairo_get_matrix(cr, &matrix);
+    if (matrix.xx != 1.0 || matrix.yy != 1.0 ||
+        matrix.xy != 0.0 || matrix.yx != 0.0)
+        return false;
+
+#if CAIRO_VERSION >= CAIRO_VERSION_ENCODE(1, 14, 0)
+    double scale_x;
+    double scale_y;
+    cairo_surface_get_device_scale(target, &scale_x, &scale_y);
+    if (scale_x != 1.0 || scale_y != 1.0)
+        return false;
+#endif
+
+    double offset_x;
+    double offset_y;
+    cairo_surface_get_device_offset(target, &offset_x, &offset_y);
+    const auto tx = matrix.x0 + offset_x;
+    const auto ty = matrix.y0 + offset_y;
+
+    // the clip must be made of whole device pixels
+    std::unique_ptr<cairo_rectangle_list_t, decltype(cairo_rectangle_list_destroy)*>
+    clip(cairo_copy_clip_rectangle_list(cr), cairo_rectangle_list_destroy);
+    if (!clip || clip->status != CAIRO_STATUS_SUCCESS)
+        return false;
+
+    std::vector<Rect> clips;
+    clips.reserve(clip->num_rectangles);
+    for (auto c = 0; c < clip->num_rectangles; ++c)
+    {
+        const auto& r = clip->rectangles[c];
+        const auto x = r.x + tx;
+        const auto y = r.y + ty;
+        if (x != std::floor(x) || y != std::floor(y) ||
+            r.width != std::floor(r.width) || r.height != std::floor(r.height))
+            return false;
+
+        clips.emplace_back(static_cast<int>(x), static_cast<int>(y),
+                           static_cast<int>(r.width), static_cast<int>(r.height));
+    }
+
+    auto& atlas = get(cairo_get_scaled_font(cr));
+    atlas.m_retired.clear();
+
+    // look everything up first, so nothing is drawn if a glyph can't be
+    struct Placed
+    {
+        Entry entry;
+        int x;
+        int y;
+    };
+    std::vector<Placed> placed;
+    placed.reserve(num_glyphs);
+    for (auto i = 0; i < num_glyphs; ++i)
+    {
+        const auto px = glyphs[i].x + tx;
+        const auto py = glyphs[i].y + ty;
+
+        auto ix = static_cast<int>(std::floor(px));
+        auto subpixel = static_cast<int>(std::lround((px - ix) * SUBPIXEL_X));
+        if (subpixel == SUBPIXEL_X)
+        {
+            ix++;
+            subpixel = 0;
+        }
+
+        const auto& entry = atlas.lookup(glyphs[i].index, subpixel);
+        if (entry.too_big)
+            return false;
+        if (!entry.page)
+            continue;
+
+        // copied, a later lookup may reset the atlas
+        placed.push_back({entry, ix + entry.left, static_cast<int>(std::lround(py)) + entry.top});
+    }
+
+    cairo_surface_flush(target);
+
+    auto data = cairo_image_surface_get_data(target);
+    const auto stride = cairo_image_surface_get_stride(target);
+    const auto width = cairo_image_surface_get_width(target);
+    const auto height = cairo_image_surface_get_height(target);
+    if (!data)
+        return false;
+
+    // premultiplied 8 bit color
+    const auto ca = static_cast<uint32_t>(std::lround(alpha * 255.));
+    const auto red8 = static_cast<uint32_t>(std::lround(red * alpha * 255.));
+    const auto green8 = static_cast<uint32_t>(std::lround(green * alpha * 255.));
+    const auto blue8 = static_cast<uint32_t>(std::lround(blue * alpha * 255.));
+
+    Rect dirty;
+    const Rect bounds(0, 0, width, height);
+
+    for (const auto& p : placed)
+    {
+        const auto& e = p.entry;
+        const Rect dest(p.x, p.y, e.width, e.height);
+
+        const auto mask = cairo_image_surface_get_data(e.page);
+        const auto mask_stride = cairo_image_surface_get_stride(e.page);
+
+        for (const auto& c : clips)
+        {
+            auto r = Rect::intersection(Rect::intersection(dest, c), bounds);
+            if (r.empty())
+                continue;
+
+            for (auto y = r.y(); y < r.y() + r.height(); ++y)
+            {
+                auto row = reinterpret_cast<uint32_t*>(data + y * stride) + r.x();
+                const auto mrow = mask + (e.y + y - p.y) * mask_stride + e.x + (r.x() - p.x);
+                blend_row(row, mrow, r.width(), ca, red8, green8, blue8);
+            }
+
+            dirty = dirty.empty() ? r : Rect::merge(dirty, r);
+        }
+    }
+
+    if (!dirty.empty())
+        cairo_surface_mark_dirty_rectangle(target,
+                                           dirty.x() - static_cast<int>(offset_x),
+                                           dirty.y() - static_cast<int>(offset_y),
+                                           dirty.width(), dirty.height());
+
+    return true;
+}
+
+}
+}
+}
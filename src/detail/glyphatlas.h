@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_SRC_DETAIL_GLYPHATLAS_H
+#define EGT_SRC_DETAIL_GLYPHATLAS_H
+
+#include <cairo.h>
+#include <cstdint>
+#include <egt/detail/meta.h>
+#include <egt/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Software glyph renderer backed by an A8 atlas.
+ *
+ * Each glyph of a scaled font is rasterized once per subpixel position into
+ * an A8 atlas page.  Drawing text is then a blend of the glyph masks straight
+ * into the pixels of the target image surface, and cairo and FreeType are
+ * only called on an atlas miss.  For short strings this avoids most of the
+ * per call overhead of cairo_show_glyphs().
+ *
+ * Only the common case is handled: a solid source, the OVER operator, a
+ * translation only transform, a rectangular clip, and an ARGB32 or RGB24
+ * image target.  Everything else is left to cairo.
+ */
+class EGT_API GlyphAtlas
+{
+public:
+
+    /// Number of horizontal subpixel positions glyphs are rasterized at.
+    static constexpr int SUBPIXEL_X = 4;
+
+    /// Width and height of an atlas page.
+    static constexpr int PAGE_SIZE = 256;
+
+    /// Number of pages before the atlas is emptied and starts over.
+    static constexpr size_t MAX_PAGES = 4;
+
+    /**
+     * Draw glyphs to the current target of @b cr, like cairo_show_glyphs().
+     *
+     * @return false, without drawing anything, if the state of @b cr is not
+     * supported and cairo_show_glyphs() should be used instead.
+     */
+    static bool show_glyphs(cairo_t* cr, const cairo_glyph_t* glyphs, int num_glyphs);
+
+    /**
+     * Returns true unless disabled with the EGT_NO_GLYPH_ATLAS environment
+     * variable.
+     */
+    static bool enabled();
+
+    /**
+     * Get the number of atlas pages of a scaled font.
+     */
+    static size_t page_count(cairo_scaled_font_t* font);
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+private:
+
+    /// A rasterized glyph.
+    struct Entry
+    {
+        /// Atlas page, or nullptr if the glyph has no ink.
+        cairo_surface_t* page{nullptr};
+        int x{0};
+        int y{0};
+        int width{0};
+        int height{0};
+        /// Offset of the mask from the pen position.
+        int left{0};
+        int top{0};
+        /// The glyph does not fit in a page.
+        bool too_big{false};
+    };
+
+    explicit GlyphAtlas(cairo_scaled_font_t* font);
+
+    /// Get the atlas of a scaled font, created on first use.
+    static GlyphAtlas& get(cairo_scaled_font_t* font);
+
+    /// Find or rasterize a glyph.
+    const Entry& lookup(unsigned long index, int subpixel);
+
+    /// Rasterize a glyph into the atlas.
+    Entry rasterize(unsigned long index, int subpixel);
+
+    /// Reserve space for a mask in the atlas.
+    bool allocate(int width, int height, Entry& entry);
+
+    /// The font, not referenced because it owns this.
+    cairo_scaled_font_t* m_font;
+    /// Atlas pages.
+    std::vector<shared_cairo_surface_t> m_pages;
+    /// Pages dropped on a reset, kept until the draw using them is done.
+    std::vector<shared_cairo_surface_t> m_retired;
+    /// Shelf packing state of the last page.
+    int m_shelf_x{0};
+    int m_shelf_y{0};
+    int m_shelf_height{0};
+    /// Rasterized glyphs by glyph index and subpixel position.
+    std::unordered_map<uint64_t, Entry> m_entries;
+};
+
+}
+}
+}
+
+#endif
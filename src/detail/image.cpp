@@ -13,7 +13,10 @@
 #include "egt/detail/filesystem.h"
 #include "egt/detail/image.h"
 #include "egt/resource.h"
+#include "egt/respath.h"
 #include "images/bmp/cairo_bmp.h"
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
@@ -327,6 +330,214 @@ private:
     }
 };
 
+static inline uint32_t read_be16(const unsigned char* p)
+{
+    return (p[0] << 8) | p[1];
+}
+
+static inline uint32_t read_be32(const unsigned char* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+static inline uint32_t read_le32(const unsigned char* p)
+{
+    return (uint32_t(p[3]) << 24) | (uint32_t(p[2]) << 16) | (uint32_t(p[1]) << 8) | p[0];
+}
+
+#ifdef HAVE_LIBJPEG
+static Size probe_jpeg_size(const unsigned char* data, size_t len)
+{
+    size_t offset = 2;
+    while (offset + 9 <= len)
+    {
+        if (data[offset] != 0xFF)
+            return {};
+
+        const auto marker = data[offset + 1];
+        // fill bytes and standalone markers
+        if (marker == 0xFF)
+        {
+            offset++;
+            continue;
+        }
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7))
+        {
+            offset += 2;
+            continue;
+        }
+
+        // SOF0-SOF15, except DHT, JPG, and DAC
+        if (marker >= 0xC0 && marker <= 0xCF &&
+            marker != 0xC4 && marker != 0xC8 && marker != 0xCC)
+        {
+            return {static_cast<DefaultDim>(read_be16(data + offset + 7)),
+                    static_cast<DefaultDim>(read_be16(data + offset + 5))};
+        }
+
+        // start of scan without a frame header
+        if (marker == 0xDA)
+            return {};
+
+        offset += 2 + read_be16(data + offset + 2);
+    }
+
+    return {};
+}
+#endif
+
+Size probe_image_size(const unsigned char* data, size_t len)
+{
+    if (!data || len < 4)
+        return {};
+
+    const auto mimetype = BasicMimeTypeDetector().get_mime_type(data, len);
+
+    if (mimetype == MIME_PNG)
+    {
+        // signature, then IHDR is always the first chunk
+        if (len >= 24 && !memcmp(data + 12, "IHDR", 4))
+            return {static_cast<DefaultDim>(read_be32(data + 16)),
+                    static_cast<DefaultDim>(read_be32(data + 20))};
+    }
+    else if (mimetype == MIME_ERAW)
+    {
+        if (len >= 12)
+            return {static_cast<DefaultDim>(read_le32(data + 4)),
+                    static_cast<DefaultDim>(read_le32(data + 8))};
+    }
+    else if (mimetype == MIME_BMP)
+    {
+        // only BITMAPINFOHEADER and later, height is negative for top-down
+        if (len >= 26 && read_le32(data + 14) >= 40)
+            return {static_cast<DefaultDim>(static_cast<int32_t>(read_le32(data + 18))),
+                    std::abs(static_cast<DefaultDim>(static_cast<int32_t>(read_le32(data + 22))))};
+    }
+#ifdef HAVE_LIBJPEG
+    else if (mimetype == MIME_JPEG)
+    {
+        return probe_jpeg_size(data, len);
+    }
+#endif
+
+    return {};
+}
+
+Size probe_image_size(const std::string& uri)
+{
+    std::string path;
+    const auto type = detail::resolve_path(uri, path);
+
+    switch (type)
+    {
+    case detail::SchemeType::resource:
+    {
+        auto& resources = ResourceManager::instance();
+        if (!resources.exists(path.c_str()))
+            return {};
+        return probe_image_size(resources.data(path.c_str()),
+                                resources.size(path.c_str()));
+    }
+    case detail::SchemeType::filesystem:
+    {
+        static const size_t HEADER_SIZE = 32;
+        // JPEG frame headers can be preceded by large EXIF segments
+        static const size_t JPEG_PROBE_SIZE = 64 * 1024;
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return {};
+
+        std::vector<unsigned char> buffer(HEADER_SIZE);
+        in.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+        size_t len = in.gcount();
+        auto size = probe_image_size(buffer.data(), len);
+        if (size.empty() && len == HEADER_SIZE &&
+            BasicMimeTypeDetector().get_mime_type(buffer.data(), len) == MIME_JPEG)
+        {
+            buffer.resize(JPEG_PROBE_SIZE);
+            in.read(reinterpret_cast<char*>(buffer.data() + len), buffer.size() - len);
+            len += in.gcount();
+            size = probe_image_size(buffer.data(), len);
+        }
+        return size;
+    }
+    default:
+        break;
+    }
+
+    return {};
+}
+
+static cairo_user_data_key_t opaque_key;
+static int opaque_true;
+static int opaque_false;
+
+bool scan_opaque(cairo_surface_t* surface)
+{
+    if (!surface)
+        return false;
+
+    const auto memo = cairo_surface_get_user_data(surface, &opaque_key);
+    if (memo)
+        return memo == &opaque_true;
+
+    bool opaque = false;
+    switch (cairo_image_surface_get_format(surface))
+    {
+    case CAIRO_FORMAT_RGB24:
+    case CAIRO_FORMAT_RGB16_565:
+    case CAIRO_FORMAT_RGB30:
+        opaque = true;
+        break;
+    case CAIRO_FORMAT_ARGB32:
+    {
+        cairo_surface_flush(surface);
+        const auto data = cairo_image_surface_get_data(surface);
+        const auto width = cairo_image_surface_get_width(surface);
+        const auto height = cairo_image_surface_get_height(surface);
+        const auto stride = cairo_image_surface_get_stride(surface);
+        if (!data)
+            break;
+
+        opaque = true;
+        for (auto y = 0; y < height && opaque; ++y)
+        {
+            const auto row = reinterpret_cast<const uint32_t*>(data + y * stride);
+            // AND the whole row so the loop vectorizes, check once per row
+            uint32_t alpha = 0xff000000;
+            for (auto x = 0; x < width; ++x)
+                alpha &= row[x];
+            opaque = alpha == 0xff000000;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    mark_opaque(surface, opaque);
+
+    return opaque;
+}
+
+void mark_opaque(cairo_surface_t* surface, bool opaque)
+{
+    if (!surface)
+        return;
+
+    cairo_surface_set_user_data(surface, &opaque_key,
+                                opaque ? &opaque_true : &opaque_false, nullptr);
+}
+
+bool is_opaque(cairo_surface_t* surface)
+{
+    if (!surface)
+        return false;
+
+    return cairo_surface_get_user_data(surface, &opaque_key) == &opaque_true;
+}
+
 std::string get_mime_type(const void* buffer, size_t length)
 {
     if (!buffer || !length)
@@ -7,6 +7,7 @@
 #include "config.h"
 #endif
 
+#include "detail/diskcache.h"
 #include "detail/dump.h"
 #include "detail/egtlog.h"
 #include "egt/detail/image.h"
@@ -42,8 +43,25 @@ shared_cairo_surface_t ImageCache::get(const std::string& uri,
 
     EGTLOG_DEBUG("image cache miss {} hscale:{} vscale:{}", uri, hscale, vscale);
 
+    uint64_t key = 0;
+    if (disk_cache().enabled())
+    {
+        const auto source = DiskCache::source_hash(uri);
+        if (source)
+            key = DiskCache::hash(source, nameid);
+    }
+
     shared_cairo_surface_t image;
 
+    if (key)
+        image = disk_cache().load(key);
+
+    if (image)
+    {
+        m_cache.insert(std::make_pair(nameid, image));
+        return image;
+    }
+
     if (detail::float_equal(hscale, 1.0f) &&
         detail::float_equal(vscale, 1.0f))
     {
@@ -100,6 +118,12 @@ shared_cairo_surface_t ImageCache::get(const std::string& uri,
                                      "cairo: {}: {}", cairo_status_to_string(cairo_surface_status(image.get())), uri));
     }
 
+    // scan once here, so drawing never has to
+    detail::scan_opaque(image.get());
+
+    if (key)
+        disk_cache().store(key, image);
+
     m_cache.insert(std::make_pair(nameid, image));
 
     return image;
@@ -110,6 +134,26 @@ void ImageCache::clear()
     m_cache.clear();
 }
 
+void ImageCache::cache_directory(const std::string& dir)
+{
+    disk_cache().directory(dir);
+}
+
+const std::string& ImageCache::cache_directory() const
+{
+    return disk_cache().directory();
+}
+
+void ImageCache::cache_size_limit(size_t bytes)
+{
+    disk_cache().size_limit(bytes);
+}
+
+size_t ImageCache::cache_size_limit() const
+{
+    return disk_cache().size_limit();
+}
+
 float ImageCache::round(float v, float fraction)
 {
     return floorf(v) + floorf((v - floorf(v)) / fraction) * fraction;
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "egt/detail/kinetic.h"
+#include <algorithm>
+#include <cmath>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+constexpr std::chrono::milliseconds KineticScroller::FRAME_INTERVAL;
+
+/// Only the movement over this much time before release sets the velocity.
+static constexpr auto VELOCITY_WINDOW = std::chrono::milliseconds(100);
+/// Slowest release, in pixels per second, that starts a fling.
+static constexpr float MIN_FLING_VELOCITY = 50;
+/// Fastest fling, in pixels per second.
+static constexpr float MAX_FLING_VELOCITY = 8000;
+/// A fling stops below this velocity, in pixels per second.
+static constexpr float STOP_VELOCITY = 10;
+/// Rate the velocity decays with, per second.
+static constexpr float FRICTION = 3.f;
+/// Stiffness of the spring that pulls the offset back inside the bounds.
+static constexpr float SPRING = 150.f;
+/// Critical damping of the spring, so it does not oscillate.
+static const float DAMPING = 2.f * std::sqrt(SPRING);
+/// Fraction of the drag past the bounds that moves the offset.
+static constexpr float RESISTANCE = 0.5f;
+/// Longest time step integrated at once, in seconds.
+static constexpr float MAX_STEP = 0.004f;
+
+KineticScroller::KineticScroller(Callback callback)
+    : m_callback(std::move(callback))
+{}
+
+void KineticScroller::begin(const PointF& offset)
+{
+    stop();
+    m_offset = offset;
+    m_sample_count = 0;
+}
+
+PointF KineticScroller::drag(const PointF& offset)
+{
+    auto& sample = m_samples[m_sample_count++ % m_samples.size()];
+    sample.offset = offset;
+    sample.time = clock::now();
+
+    const auto resist = [this](float pos, float min, float max)
+    {
+        if (pos < min)
+            return m_overscroll ? min - (min - pos) * RESISTANCE : min;
+        if (pos > max)
+            return m_overscroll ? max + (pos - max) * RESISTANCE : max;
+        return pos;
+    };
+
+    m_offset = PointF(resist(offset.x(), m_min.x(), m_max.x()),
+                      resist(offset.y(), m_min.y(), m_max.y()));
+    return m_offset;
+}
+
+void KineticScroller::release()
+{
+    m_velocity = {};
+
+    const auto now = clock::now();
+    const auto count = std::min(m_sample_count, m_samples.size());
+    if (count >= 2)
+    {
+        const auto& newest = m_samples[(m_sample_count - 1) % m_samples.size()];
+
+        // a pointer that stopped before it was lifted does not fling
+        if (now - newest.time <= VELOCITY_WINDOW)
+        {
+            auto oldest = &newest;
+            for (size_t x = 2; x <= count; ++x)
+            {
+                const auto& sample = m_samples[(m_sample_count - x) % m_samples.size()];
+                if (newest.time - sample.time > VELOCITY_WINDOW)
+                    break;
+                oldest = &sample;
+            }
+
+            const auto dt = std::chrono::duration<float>(newest.time - oldest->time).count();
+            if (dt > 0)
+            {
+                const auto clamp_velocity = [](float v)
+                {
+                    return std::max(-MAX_FLING_VELOCITY, std::min(v, MAX_FLING_VELOCITY));
+                };
+
+                m_velocity = PointF(clamp_velocity((newest.offset.x() - oldest->offset.x()) / dt),
+                                    clamp_velocity((newest.offset.y() - oldest->offset.y()) / dt));
+            }
+        }
+    }
+
+    const bool inside = m_offset.x() >= m_min.x() && m_offset.x() <= m_max.x() &&
+                        m_offset.y() >= m_min.y() && m_offset.y() <= m_max.y();
+
+    if (inside &&
+        std::abs(m_velocity.x()) < MIN_FLING_VELOCITY &&
+        std::abs(m_velocity.y()) < MIN_FLING_VELOCITY)
+        return;
+
+    if (!m_timer)
+    {
+        m_timer = std::make_unique<PeriodicTimer>(FRAME_INTERVAL);
+        m_timer->on_timeout([this]()
+        {
+            step();
+        });
+    }
+
+    m_last = now;
+    m_timer->start();
+}
+
+void KineticScroller::stop()
+{
+    if (m_timer)
+        m_timer->cancel();
+    m_velocity = {};
+}
+
+bool KineticScroller::step_axis(float& pos, float& velocity, float min, float max, float dt) const
+{
+    if (m_overscroll && (pos < min || pos > max))
+    {
+        // spring back to the bound
+        const auto bound = pos < min ? min : max;
+        velocity += (-SPRING * (pos - bound) - DAMPING * velocity) * dt;
+        pos += velocity * dt;
+
+        if (std::abs(pos - bound) < 0.5f && std::abs(velocity) < STOP_VELOCITY)
+        {
+            pos = bound;
+            velocity = 0;
+            return false;
+        }
+
+        return true;
+    }
+
+    velocity *= std::exp(-FRICTION * dt);
+    pos += velocity * dt;
+
+    if (!m_overscroll && (pos < min || pos > max))
+    {
+        pos = std::max(min, std::min(pos, max));
+        velocity = 0;
+    }
+
+    if (std::abs(velocity) < STOP_VELOCITY)
+    {
+        velocity = 0;
+        // past the bounds, the spring still has to pull it back
+        return pos < min || pos > max;
+    }
+
+    return true;
+}
+
+void KineticScroller::step()
+{
+    const auto now = clock::now();
+    auto dt = std::min(std::chrono::duration<float>(now - m_last).count(), 0.1f);
+    m_last = now;
+
+    auto x = m_offset.x();
+    auto y = m_offset.y();
+    auto vx = m_velocity.x();
+    auto vy = m_velocity.y();
+
+    bool moving = true;
+    while (dt > 0 && moving)
+    {
+        const auto h = std::min(dt, MAX_STEP);
+        const auto mx = step_axis(x, vx, m_min.x(), m_max.x(), h);
+        const auto my = step_axis(y, vy, m_min.y(), m_max.y(), h);
+        moving = mx || my;
+        dt -= h;
+    }
+
+    m_offset = PointF(x, y);
+    m_velocity = PointF(vx, vy);
+
+    if (!moving)
+        m_timer->cancel();
+
+    if (m_callback)
+        m_callback(m_offset);
+}
+
+}
+}
+}
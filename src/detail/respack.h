@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_SRC_DETAIL_RESPACK_H
+#define EGT_SRC_DETAIL_RESPACK_H
+
+/**
+ * @file
+ * @brief EGT resource pack file format.
+ *
+ * A resource pack is a single file holding many resources that is mapped into
+ * memory as a whole and resolved lazily by name.  All values are little
+ * endian.
+ *
+ *     [PackHeader]
+ *     [PackEntry] * count      sorted by hash, then name
+ *     [name table]
+ *     [data]...
+ *
+ * This header is shared with the standalone pack tool in tools/, so it must
+ * not depend on anything but the standard library.
+ */
+
+#include <cstdint>
+#include <cstring>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+namespace respack
+{
+
+/// Pack file magic ("EGPK").
+constexpr uint32_t MAGIC = 0x4b504745;
+
+/// Current pack file version.
+constexpr uint32_t VERSION = 1;
+
+/// Entry data is zlib compressed and must be inflated before use.
+constexpr uint32_t FLAG_ZLIB = 1u << 0;
+
+struct PackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    /// Number of PackEntry items following the header.
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct PackEntry
+{
+    /// hash() of the entry name.
+    uint32_t hash;
+    /// FLAG_* bits.
+    uint32_t flags;
+    /// Offset of the name from the start of the file.
+    uint32_t name_offset;
+    /// Length of the name, without a terminator.
+    uint32_t name_len;
+    /// Offset of the data from the start of the file.
+    uint64_t offset;
+    /// Size of the data as stored in the file.
+    uint32_t size;
+    /// Size of the data once inflated.
+    uint32_t raw_size;
+};
+
+static_assert(sizeof(PackHeader) == 16, "unexpected PackHeader size");
+static_assert(sizeof(PackEntry) == 32, "unexpected PackEntry size");
+
+/// 32 bit FNV-1a hash of a resource name.
+inline uint32_t hash(const char* str, size_t len)
+{
+    uint32_t h = 2166136261u;
+    for (size_t x = 0; x < len; ++x)
+    {
+        h ^= static_cast<unsigned char>(str[x]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/// Ordering of entries in the index.
+inline int compare(uint32_t hash, const char* name, size_t len,
+                   const PackEntry& entry, const char* entry_name)
+{
+    if (hash != entry.hash)
+        return hash < entry.hash ? -1 : 1;
+    const auto n = len < entry.name_len ? len : entry.name_len;
+    const auto r = memcmp(name, entry_name, n);
+    if (r)
+        return r;
+    if (len == entry.name_len)
+        return 0;
+    return len < entry.name_len ? -1 : 1;
+}
+
+}
+}
+}
+}
+
+#endif
@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include "detail/utf8text.h"
+#include "egt/detail/textdocument.h"
+#include <algorithm>
+#include <cstring>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/// Smallest gap allocated when the buffer grows.
+constexpr size_t MIN_GAP = 4096;
+
+static inline bool is_lead_byte(char c)
+{
+    return (static_cast<unsigned char>(c) & 0xc0) != 0x80;
+}
+
+TextDocument::TextDocument()
+{
+    m_lines.emplace_back(0, 0);
+}
+
+TextDocument::TextDocument(const std::string& text)
+    : TextDocument()
+{
+    insert(0, text);
+}
+
+void TextDocument::assign(const std::string& text)
+{
+    clear();
+    insert(0, text);
+}
+
+void TextDocument::clear()
+{
+    m_buf.clear();
+    m_buf.shrink_to_fit();
+    m_gap_start = m_gap_end = 0;
+    m_length = 0;
+    m_lines.clear();
+    m_lines.emplace_back(0, 0);
+    m_step_line = 0;
+    m_step_offset = m_step_pos = 0;
+    m_layout_first = m_layout_last = 0;
+    m_str.clear();
+    m_str_valid = true;
+}
+
+size_t TextDocument::line_at(size_t pos) const
+{
+    // the last line that starts at or before pos
+    size_t first = 1;
+    size_t count = m_lines.size() - 1;
+    while (count)
+    {
+        const auto step = count / 2;
+        if (pos < line_pos(first + step))
+        {
+            count = step;
+        }
+        else
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+    }
+    return first - 1;
+}
+
+size_t TextDocument::line_length(size_t line) const
+{
+    if (line + 1 < m_lines.size())
+        return line_pos(line + 1) - line_pos(line) - 1;
+    return m_length - line_pos(line);
+}
+
+std::string TextDocument::line(size_t line) const
+{
+    const auto begin = line_offset(line);
+    const auto end = line + 1 < m_lines.size() ? line_offset(line + 1) - 1 : size();
+
+    std::string result;
+    copy(begin, end - begin, result);
+    return result;
+}
+
+size_t TextDocument::offset(size_t pos) const
+{
+    const auto line = line_at(pos);
+
+    // lines are short, so scanning from the start of the line is cheap
+    auto result = line_offset(line);
+    const auto end = size();
+    for (auto n = pos - line_pos(line); n && result < end; --n)
+    {
+        ++result;
+        while (result < end && !is_lead_byte(at(result)))
+            ++result;
+    }
+
+    return result;
+}
+
+void TextDocument::move_step(size_t line)
+{
+    line = std::min(line, m_lines.size());
+
+    // only the lines between the old and the new start change
+    if (m_step_offset || m_step_pos)
+    {
+        if (line > m_step_line)
+        {
+            for (auto i = m_step_line; i < line; ++i)
+            {
+                m_lines[i].offset += m_step_offset;
+                m_lines[i].pos += m_step_pos;
+            }
+        }
+        else
+        {
+            for (auto i = line; i < m_step_line; ++i)
+            {
+                m_lines[i].offset -= m_step_offset;
+                m_lines[i].pos -= m_step_pos;
+            }
+        }
+    }
+
+    m_step_line = line;
+    if (m_step_line == m_lines.size())
+        m_step_offset = m_step_pos = 0;
+}
+
+void TextDocument::copy(size_t offset, size_t len, std::string& out) const
+{
+    out.reserve(out.size() + len);
+
+    if (offset < m_gap_start)
+    {
+        const auto n = std::min(len, m_gap_start - offset);
+        out.append(m_buf.data() + offset, n);
+        offset += n;
+        len -= n;
+    }
+
+    if (len)
+        out.append(m_buf.data() + offset + m_gap_end - m_gap_start, len);
+}
+
+void TextDocument::move_gap(size_t offset)
+{
+    if (offset < m_gap_start)
+    {
+        const auto n = m_gap_start - offset;
+        memmove(m_buf.data() + m_gap_end - n, m_buf.data() + offset, n);
+        m_gap_start -= n;
+        m_gap_end -= n;
+    }
+    else if (offset > m_gap_start)
+    {
+        const auto n = offset - m_gap_start;
+        memmove(m_buf.data() + m_gap_start, m_buf.data() + m_gap_end, n);
+        m_gap_start += n;
+        m_gap_end += n;
+    }
+}
+
+void TextDocument::reserve_gap(size_t len)
+{
+    if (m_gap_end - m_gap_start >= len)
+        return;
+
+    const auto used = size();
+    const auto capacity = std::max(m_buf.size() * 2, used + len + MIN_GAP);
+    const auto tail = m_buf.size() - m_gap_end;
+
+    std::vector<char> buf(capacity);
+    if (m_gap_start)
+        memcpy(buf.data(), m_buf.data(), m_gap_start);
+    if (tail)
+        memcpy(buf.data() + capacity - tail, m_buf.data() + m_gap_end, tail);
+
+    m_buf = std::move(buf);
+    m_gap_end = capacity - tail;
+}
+
+void TextDocument::insert(size_t pos, const std::string& str)
+{
+    if (str.empty())
+        return;
+
+    pos = std::min(pos, m_length);
+    const auto line = line_at(pos);
+    const auto start = offset(pos);
+
+    reserve_gap(str.size());
+    move_gap(start);
+    memcpy(m_buf.data() + m_gap_start, str.data(), str.size());
+    m_gap_start += str.size();
+
+    // new lines start after each line break in str
+    std::vector<Line> added;
+    size_t count = 0;
+    for (size_t x = 0; x < str.size(); ++x)
+    {
+        if (!is_lead_byte(str[x]))
+            continue;
+        count++;
+        if (str[x] == '\n')
+            added.emplace_back(start + x + 1, pos + count);
+    }
+
+    // the lines after this one are shifted when they are next needed
+    move_step(line + 1);
+
+    if (!added.empty())
+    {
+        m_lines.insert(m_lines.begin() + line + 1,
+                       std::make_move_iterator(added.begin()),
+                       std::make_move_iterator(added.end()));
+        m_step_line += added.size();
+        if (m_layout_first > line)
+            m_layout_first += added.size();
+        if (m_layout_last > line)
+            m_layout_last += added.size();
+    }
+
+    m_step_offset += str.size();
+    m_step_pos += count;
+
+    m_lines[line].layout.reset();
+    m_length += count;
+    m_str_valid = false;
+}
+
+void TextDocument::erase(size_t pos, size_t len)
+{
+    if (pos >= m_length)
+        return;
+    len = std::min(len, m_length - pos);
+    if (!len)
+        return;
+
+    const auto line = line_at(pos);
+    const auto start = offset(pos);
+    const auto end = offset(pos + len);
+
+    move_gap(start);
+    m_gap_end += end - start;
+
+    // lines starting inside the erased range lost their line break
+    const auto removed = line_at(pos + len) - line;
+    move_step(line + 1);
+    m_lines.erase(m_lines.begin() + line + 1, m_lines.begin() + line + 1 + removed);
+
+    // the lines after this one are shifted when they are next needed
+    m_step_offset -= end - start;
+    m_step_pos -= len;
+
+    const auto shift = [line, removed](size_t & index)
+    {
+        if (index > line + removed)
+            index -= removed;
+        else if (index > line)
+            index = line + 1;
+    };
+    shift(m_layout_first);
+    shift(m_layout_last);
+
+    m_lines[line].layout.reset();
+    m_length -= len;
+    m_str_valid = false;
+}
+
+std::string TextDocument::substr(size_t pos, size_t len) const
+{
+    if (pos >= m_length)
+        return {};
+    len = std::min(len, m_length - pos);
+
+    const auto start = offset(pos);
+    const auto end = offset(pos + len);
+
+    std::string result;
+    copy(start, end - start, result);
+    return result;
+}
+
+const std::string& TextDocument::str() const
+{
+    if (!m_str_valid)
+    {
+        m_str.clear();
+        copy(0, size(), m_str);
+        m_str_valid = true;
+    }
+
+    return m_str;
+}
+
+const TextDocument::LineLayout& TextDocument::layout(size_t line, const Font& font) const
+{
+    if (m_layout_font != font)
+    {
+        keep_layouts(0, 0);
+        m_layout_font = font;
+    }
+
+    auto& l = m_lines[line];
+    if (l.layout)
+        return *l.layout;
+
+    std::unique_ptr<LineLayout> layout(new LineLayout);
+    layout_line(this->line(line), font, *layout);
+
+    if (m_layout_first == m_layout_last)
+    {
+        m_layout_first = line;
+        m_layout_last = line + 1;
+    }
+    else
+    {
+        m_layout_first = std::min(m_layout_first, line);
+        m_layout_last = std::max(m_layout_last, line + 1);
+    }
+
+    l.layout = std::move(layout);
+    return *l.layout;
+}
+
+void TextDocument::layout_line(const std::string& text, const Font& font,
+                               LineLayout& layout)
+{
+    auto& metrics = FontMetrics::get(font.scaled_font());
+
+    layout.run.clear();
+    layout.x.clear();
+    layout.indexed = true;
+    layout.run.reserve(text.size());
+    layout.x.reserve(text.size() + 1);
+
+    float x = 0;
+    utf8_for_each(text.data(), text.size(), [&](uint32_t cp, uint32_t, uint32_t)
+    {
+        const auto& g = metrics.glyph(cp);
+        if (!g.simple)
+            layout.indexed = false;
+
+        layout.x.push_back(x);
+        layout.run.push_back({g.index, x, 0});
+        x += g.x_advance;
+    });
+    layout.x.push_back(x);
+}
+
+void TextDocument::keep_layouts(size_t first, size_t last) const
+{
+    const auto end = std::min(m_layout_last, m_lines.size());
+    for (auto line = m_layout_first; line < end; ++line)
+    {
+        if (line < first || line >= last)
+            m_lines[line].layout.reset();
+    }
+
+    m_layout_first = std::max(m_layout_first, first);
+    m_layout_last = std::min(end, last);
+    if (m_layout_first >= m_layout_last)
+        m_layout_first = m_layout_last = 0;
+}
+
+}
+}
+}
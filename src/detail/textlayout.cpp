@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include "detail/glyphatlas.h"
+#include "detail/utf8text.h"
+#include "egt/detail/layout.h"
+#include "egt/detail/textlayout.h"
+#include "egt/image.h"
+#include "egt/painter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+enum
+{
+    // When in a wrapping container, put this element on a new line. Wrapping
+    // layout code auto-inserts LAY_BREAK flags as needed. See GitHub issues for
+    // TODO related to this.
+    //
+    // Drawing routines can read this via item pointers as needed after
+    // performing layout calculations.
+    LAY_BREAK = 0x200
+};
+
+#define fl(f) static_cast<float>(f)
+
+bool TextLayout::update(const Size& size,
+                        const std::string& text,
+                        const Font& font,
+                        bool multiline,
+                        bool word_wrap,
+                        const AlignFlags& text_align,
+                        Justification justify,
+                        const AlignFlags& image_align,
+                        const Size& image_size)
+{
+    const bool reshape = !m_valid ||
+                         m_multiline != multiline ||
+                         m_word_wrap != word_wrap ||
+                         m_font != font ||
+                         m_text != text;
+
+    if (!reshape &&
+        m_size == size &&
+        m_text_align == text_align &&
+        m_justify == justify &&
+        m_image_align == image_align &&
+        m_image_size == image_size)
+        return false;
+
+    if (reshape)
+    {
+        m_text = text;
+        m_font = font;
+        m_multiline = multiline;
+        m_word_wrap = word_wrap;
+        shape();
+    }
+
+    m_size = size;
+    m_text_align = text_align;
+    m_justify = justify;
+    m_image_align = image_align;
+    m_image_size = image_size;
+    m_has_image = !image_size.empty();
+    position();
+    m_valid = true;
+
+    return true;
+}
+
+void TextLayout::shape()
+{
+    m_shaped.clear();
+    m_tokens.clear();
+
+    auto& metrics = FontMetrics::get(m_font.scaled_font());
+    const auto& fe = metrics.font_extents();
+    m_height = fl(fe.height);
+    m_descent = fl(fe.descent);
+
+    // whether every drawn code point maps to a single glyph
+    m_indexed = true;
+
+    // tokenize based on words or code points
+    const bool words = m_multiline && m_word_wrap;
+    bool in_word = false;
+    utf8_for_each(m_text.data(), m_text.size(), [&](uint32_t cp, uint32_t offset, uint32_t len)
+    {
+        Glyph glyph;
+        glyph.offset = offset;
+        glyph.len = len;
+
+        if (cp == '\n')
+        {
+            glyph.newline = true;
+            m_tokens.push_back({Token::Type::text, static_cast<uint32_t>(m_shaped.size()), 1, 0, true});
+            m_shaped.push_back(glyph);
+            in_word = false;
+            return;
+        }
+
+        const auto& g = metrics.glyph(cp);
+        if (!g.simple)
+            m_indexed = false;
+        glyph.cell = RectF(0, 0, g.x_advance, 0);
+        glyph.index = g.index;
+
+        const bool delimiter = cp == ' ' || cp == '\t' || cp == '\r';
+        if (in_word && !delimiter)
+        {
+            m_tokens.back().count++;
+            m_tokens.back().width += g.x_advance;
+        }
+        else
+        {
+            m_tokens.push_back({Token::Type::text, static_cast<uint32_t>(m_shaped.size()), 1, g.x_advance, false});
+        }
+        m_shaped.push_back(glyph);
+
+        in_word = words && !delimiter;
+    });
+}
+
+void TextLayout::position()
+{
+    m_order.clear();
+    m_order.insert(m_order.end(), m_tokens.begin(), m_tokens.end());
+
+    if (m_has_image)
+    {
+        const Token image{Token::Type::image, 0, 0, 0, false};
+        const Token line_break{Token::Type::line_break, 0, 0, 0, true};
+        if (m_image_align.is_set(AlignFlag::top))
+        {
+            m_order.insert(m_order.begin(), image);
+            // the break goes after the image
+            m_order.insert(m_order.begin() + 1, line_break);
+        }
+        else if (m_image_align.is_set(AlignFlag::right))
+        {
+            m_order.push_back(image);
+        }
+        else if (m_image_align.is_set(AlignFlag::bottom))
+        {
+            m_order.push_back(line_break);
+            m_order.push_back(image);
+        }
+        else
+        {
+            m_order.insert(m_order.begin(), image);
+        }
+    }
+
+    m_rects.clear();
+    m_rects.reserve(m_order.size());
+
+    uint32_t behave = 0;
+    for (const auto& t : m_order)
+    {
+        if (t.type == Token::Type::image)
+        {
+            m_rects.emplace_back(0, Rect(Point(), m_image_size));
+            behave = 0;
+        }
+        else if (t.newline)
+        {
+            m_rects.emplace_back(behave, Rect(0, 0, 1, m_height));
+            behave |= LAY_BREAK;
+        }
+        else
+        {
+            m_rects.emplace_back(behave, Rect(0, 0, t.width, m_height));
+            behave = 0;
+        }
+    }
+
+    detail::flex_layout(Rect(Point(), m_size), m_rects, m_justify, Orientation::flex, m_text_align);
+
+    // position the code points in the order they are drawn
+    m_glyphs.clear();
+    m_glyphs.reserve(m_shaped.size() + 1);
+    for (size_t x = 0; x < m_order.size(); ++x)
+    {
+        const auto& t = m_order[x];
+        const auto& r = m_rects[x];
+
+        if (t.type == Token::Type::image)
+        {
+            m_image_point = r.rect.point();
+            continue;
+        }
+
+        const auto place = [&](Glyph glyph, float roff)
+        {
+            const auto advance = glyph.cell.width();
+            glyph.cursor = PointF(fl(r.rect.x()) + roff, fl(r.rect.y()));
+            glyph.cell = RectF(fl(r.rect.x()) + roff,
+                               fl(r.rect.y()),
+                               advance,
+                               fl(r.rect.height()));
+            m_glyphs.push_back(glyph);
+            return advance;
+        };
+
+        if (t.newline && !m_multiline)
+            continue;
+
+        if (t.type == Token::Type::line_break)
+        {
+            Glyph glyph;
+            glyph.newline = true;
+            place(glyph, 0);
+            continue;
+        }
+
+        float roff = 0.;
+        for (auto g = t.first; g < t.first + t.count; ++g)
+            roff += place(m_shaped[g], roff);
+    }
+
+    // handle cursor after last character
+    if (!m_rects.empty())
+    {
+        m_end_cursor = m_rects.back().rect.point() + Point(m_rects.back().rect.width(), 0);
+
+        const auto& last = m_order.back().type == Token::Type::image && m_order.size() > 1 ?
+                           m_order[m_order.size() - 2] : m_order.back();
+        if (last.newline)
+        {
+            m_end_cursor.x(0);
+            m_end_cursor.y(m_end_cursor.y() + static_cast<int>(m_height));
+        }
+    }
+    else
+    {
+        m_end_cursor = {};
+    }
+
+    // pre-position the glyphs, so drawing is a single cairo_show_glyphs()
+    m_run.clear();
+    if (m_indexed)
+    {
+        const auto baseline = m_height - m_descent;
+        m_run.reserve(m_glyphs.size());
+        for (const auto& glyph : m_glyphs)
+        {
+            if (glyph.newline)
+                continue;
+
+            cairo_glyph_t g;
+            g.index = glyph.index;
+            g.x = glyph.cell.x();
+            g.y = glyph.cell.y() + baseline;
+            m_run.push_back(g);
+        }
+    }
+}
+
+void TextLayout::draw(Painter& painter,
+                      const Point& origin,
+                      const Pattern& text_color,
+                      const Image* image,
+                      const std::function<void(const Point& offset, size_t height)>& draw_cursor,
+                      size_t cursor_pos,
+                      const Pattern& highlight_color,
+                      size_t select_start,
+                      size_t select_len) const
+{
+    if (!m_valid)
+        return;
+
+    auto cr = painter.context().get();
+    const auto o = PointF(origin);
+
+    if (m_has_image && image && !image->empty())
+    {
+        painter.draw(o + PointF(m_image_point));
+        painter.draw(*image);
+    }
+
+    // selection first, so it never covers the text
+    if (select_len)
+    {
+        painter.set(highlight_color);
+        for (size_t pos = select_start; pos < select_start + select_len && pos < m_glyphs.size(); ++pos)
+        {
+            const auto& glyph = m_glyphs[pos];
+            if (glyph.newline)
+                continue;
+
+            const auto rect = RectF(o + glyph.cell.point(), glyph.cell.size());
+            if (!rect.empty())
+                painter.draw(rect);
+        }
+        painter.fill();
+    }
+
+    painter.set(m_font);
+    painter.set(text_color);
+    if (m_indexed)
+    {
+        if (!m_run.empty())
+        {
+            Painter::AutoSaveRestore sr(painter);
+            cairo_translate(cr, o.x(), o.y());
+            if (!GlyphAtlas::show_glyphs(cr, m_run.data(), m_run.size()))
+                cairo_show_glyphs(cr, m_run.data(), m_run.size());
+        }
+    }
+    else
+    {
+        const auto baseline = m_height - m_descent;
+        for (const auto& glyph : m_glyphs)
+        {
+            if (glyph.newline)
+                continue;
+
+            char buf[8] {};
+            memcpy(buf, m_text.data() + glyph.offset, std::min<size_t>(glyph.len, sizeof(buf) - 1));
+            cairo_move_to(cr, o.x() + glyph.cell.x(), o.y() + glyph.cell.y() + baseline);
+            cairo_show_text(cr, buf);
+        }
+    }
+    cairo_new_path(cr);
+
+    if (draw_cursor)
+    {
+        if (cursor_pos < m_glyphs.size())
+        {
+            // the cursor is drawn before the code point
+            const auto& cursor = m_glyphs[cursor_pos].cursor;
+            draw_cursor(Point(origin.x() + cursor.x(), origin.y() + cursor.y()), m_height);
+        }
+        else if (cursor_pos == m_glyphs.size())
+        {
+            draw_cursor(origin + m_end_cursor, m_height);
+        }
+    }
+}
+
+void TextLayout::clear()
+{
+    m_valid = false;
+    m_glyphs.clear();
+    m_glyphs.shrink_to_fit();
+    m_shaped.clear();
+    m_shaped.shrink_to_fit();
+    m_tokens.clear();
+    m_tokens.shrink_to_fit();
+    m_order.clear();
+    m_order.shrink_to_fit();
+    m_rects.clear();
+    m_rects.shrink_to_fit();
+    m_run.clear();
+    m_run.shrink_to_fit();
+    m_text.clear();
+}
+
+}
+}
+}
@@ -8,6 +8,8 @@
 
 #include "egt/painter.h"
 #include "egt/text.h"
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <string>
 #include <utf8.h>
@@ -23,14 +25,67 @@ namespace detail
 using utf8_const_iterator = utf8::iterator<std::string::const_iterator>;
 using utf8_iterator = utf8::iterator<std::string::iterator>;
 
+/**
+ * Returns true if a range of bytes is all ASCII.
+ *
+ * This looks at 8 bytes at a time with no branches in the loop, which the
+ * compiler is also free to turn into vector instructions.
+ */
+inline bool ascii(const char* data, size_t len)
+{
+    uint64_t bits = 0;
+    size_t x = 0;
+    for (; x + 8 <= len; x += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + x, sizeof(word));
+        bits |= word;
+    }
+    for (; x < len; ++x)
+        bits |= static_cast<unsigned char>(data[x]);
+
+    return !(bits & UINT64_C(0x8080808080808080));
+}
+
 /**
  * Returns the length of a utf-8 encoded string.
  */
 inline size_t utf8len(const std::string& str)
 {
+    if (ascii(str.data(), str.size()))
+        return str.size();
     return utf8::distance(str.begin(), str.end());
 }
 
+/**
+ * Call a function for each code point of a utf-8 encoded range of bytes.
+ *
+ * @b func is called as func(code_point, offset, len), with the byte offset
+ * and byte length of the code point.  Pure ASCII text is walked a byte at a
+ * time without decoding.
+ */
+template<class F>
+void utf8_for_each(const char* data, size_t len, F&& func)
+{
+    if (ascii(data, len))
+    {
+        for (size_t x = 0; x < len; ++x)
+            func(static_cast<uint32_t>(static_cast<unsigned char>(data[x])),
+                 static_cast<uint32_t>(x), 1U);
+        return;
+    }
+
+    const auto end = data + len;
+    for (auto pos = data; pos != end;)
+    {
+        const auto start = pos;
+        const auto cp = utf8::next(pos, end);
+        func(static_cast<uint32_t>(cp),
+             static_cast<uint32_t>(start - data),
+             static_cast<uint32_t>(pos - start));
+    }
+}
+
 /**
  * Convert a UTF-8 iterator to a standalone std::string.
  */
@@ -11,6 +11,8 @@
 #include "detail/video/gstappsinkimpl.h"
 #include "detail/video/gstmeta.h"
 #include "egt/app.h"
+#include "egt/painter.h"
+#include "egt/screen.h"
 #include "egt/types.h"
 #include "egt/uri.h"
 #include <string>
@@ -29,7 +31,8 @@ namespace detail
 
 GstAppSinkImpl::GstAppSinkImpl(VideoWindow& interface, const Size& size)
     : GstDecoderImpl(interface, size),
-      m_appsink(nullptr)
+      m_appsink(nullptr),
+      m_mailbox([this](GstSample * sample) { take(sample); })
 {
     static constexpr auto plugins =
     {
@@ -57,9 +60,11 @@ GstAppSinkImpl::GstAppSinkImpl(VideoWindow& interface, const Size& size)
 
 void GstAppSinkImpl::draw(Painter& painter, const Rect& rect)
 {
-    ignoreparam(rect);
     /*
-     * its a Basic window copying buffer to Cairo surface.
+     * The frames are in the format of the screen and scaled to the box of
+     * the window by the pipeline, so this is a copy of the damaged part.
+     * Until frames of a new size come out of the pipeline after a resize,
+     * they are scaled here instead.
      */
     if (m_videosample)
     {
@@ -77,24 +82,32 @@ void GstAppSinkImpl::draw(Painter& painter, const Rect& rect)
             GstMapInfo map;
             if (gst_buffer_map(buffer, &map, GST_MAP_READ))
             {
-                auto box = m_interface.box();
+                const auto format = detail::cairo_format(m_format);
                 auto surface = unique_cairo_surface_t(
                                    cairo_image_surface_create_for_data(map.data,
-                                           CAIRO_FORMAT_RGB16_565,
+                                           format,
                                            width,
                                            height,
-                                           cairo_format_stride_for_width(CAIRO_FORMAT_RGB16_565, width)));
+                                           cairo_format_stride_for_width(format, width)));
 
-                if (cairo_surface_status(surface.get()) == CAIRO_STATUS_SUCCESS)
+                const auto box = m_interface.box();
+                const auto area = Rect::intersection(rect, box);
+
+                if (cairo_surface_status(surface.get()) == CAIRO_STATUS_SUCCESS &&
+                    !area.empty() && width > 0 && height > 0)
                 {
+                    Painter::AutoSaveRestore sr(painter);
                     auto cr = painter.context().get();
-                    if (width != box.width() || height != box.height())
+                    cairo_rectangle(cr, area.x(), area.y(), area.width(), area.height());
+                    cairo_clip(cr);
+                    cairo_translate(cr, box.x(), box.y());
+                    if (box.size() != Size(width, height))
                     {
-                        double scalex = static_cast<double>(box.width()) / width;
-                        double scaley = static_cast<double>(box.height()) / height;
-                        cairo_scale(cr, scalex, scaley);
+                        cairo_scale(cr,
+                                    static_cast<double>(box.width()) / width,
+                                    static_cast<double>(box.height()) / height);
                     }
-                    cairo_set_source_surface(cr, surface.get(), box.x(), box.y());
+                    cairo_set_source_surface(cr, surface.get(), 0, 0);
                     cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
                     cairo_paint(cr);
                 }
@@ -105,6 +118,12 @@ void GstAppSinkImpl::draw(Painter& painter, const Rect& rect)
         }
         gst_sample_unref(m_videosample);
 
+        if (m_fresh)
+        {
+            m_fresh = false;
+            m_mailbox.mark_displayed();
+        }
+
     }
 }
 
@@ -140,6 +159,8 @@ GstFlowReturn GstAppSinkImpl::on_new_buffer(GstElement* elt, gpointer data)
                 }
 
                 // drop this frame and continue
+                impl->m_mailbox.mark_decoded();
+                impl->m_mailbox.mark_dropped();
                 gst_sample_unref(sample);
                 return GST_FLOW_OK;
             }
@@ -155,6 +176,8 @@ GstFlowReturn GstAppSinkImpl::on_new_buffer(GstElement* elt, gpointer data)
                     assert(screen);
                     memcpy(screen->raw(), map.data, map.size);
                     screen->schedule_flip();
+                    impl->m_mailbox.mark_decoded();
+                    impl->m_mailbox.mark_displayed();
                     impl->m_position = GST_BUFFER_TIMESTAMP(buffer);
                     gst_buffer_unmap(buffer, &map);
                 }
@@ -164,17 +187,7 @@ GstFlowReturn GstAppSinkImpl::on_new_buffer(GstElement* elt, gpointer data)
         else
 #endif
         {
-            if (Application::check_instance())
-            {
-                asio::post(Application::instance().event().io(), [impl, sample]()
-                {
-                    if (impl->m_videosample)
-                        gst_sample_unref(impl->m_videosample);
-
-                    impl->m_videosample = sample;
-                    impl->m_interface.damage();
-                });
-            }
+            impl->m_mailbox.put(sample);
         }
         return GST_FLOW_OK;
     }
@@ -197,7 +210,18 @@ std::string GstAppSinkImpl::create_pipeline()
     else
 #endif
     {
-        vc += "RGB16";
+        /*
+         * Ask for frames in the format of the screen they are composed on,
+         * so drawing them does not convert.  Video has no alpha, so an ARGB
+         * screen gets XRGB frames, which cairo copies as is.
+         */
+        m_format = PixelFormat::rgb565;
+        auto screen = m_interface.screen();
+        if (screen && (screen->format() == PixelFormat::argb8888 ||
+                       screen->format() == PixelFormat::xrgb8888))
+            m_format = PixelFormat::xrgb8888;
+
+        vc += detail::gstreamer_format(m_format);
     }
 
     std::string a_pipe;
@@ -217,11 +241,19 @@ std::string GstAppSinkImpl::create_pipeline()
         m_interface.resize(Size(32, 32));
     }
 
+    // without a plane, frames are scaled to the box they are drawn in
+    const auto target = m_interface.plane_window() ? m_size : m_interface.box().size();
+
     std::string vscapf = " ! capsfilter name=vcaps";
-    if ((m_size.width() > 32) && (m_size.height() > 32))
+    if ((target.width() > 32) && (target.height() > 32))
     {
         vscapf = fmt::format(vscapf + " caps=video/x-raw,width={},height={} ",
-                             m_size.width(), m_size.height());
+                             target.width(), target.height());
+        m_caps_size = target;
+    }
+    else
+    {
+        m_caps_size = {};
     }
 
     static constexpr auto pipeline =
@@ -325,24 +357,44 @@ void GstAppSinkImpl::scale(float scalex, float scaley)
 
 void GstAppSinkImpl::resize(const Size& size)
 {
-    if (size != m_size)
+    // compare with what the caps ask for, not with the original size
+    if (m_pipeline && m_vcapsfilter && size != m_caps_size)
     {
-        if (m_pipeline && m_vcapsfilter)
-        {
-            std::string vs = fmt::format("video/x-raw,width={},height={}", size.width(), size.height());
-            GstCaps* caps = gst_caps_from_string(vs.c_str());
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-            g_object_set(G_OBJECT(m_vcapsfilter), "caps", caps, NULL);
-            EGTLOG_DEBUG("change gst videoscale element to {}", size);
-            gst_caps_unref(caps);
-        }
+        std::string vs = fmt::format("video/x-raw,width={},height={}", size.width(), size.height());
+        GstCaps* caps = gst_caps_from_string(vs.c_str());
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        g_object_set(G_OBJECT(m_vcapsfilter), "caps", caps, NULL);
+        EGTLOG_DEBUG("change gst videoscale element to {}", size);
+        gst_caps_unref(caps);
+        m_caps_size = size;
+    }
 
-        if (m_size.empty())
-        {
-            m_size = size;
-            EGTLOG_DEBUG("setting m_size to {} from {}", size, m_size);
-        }
+    if (m_size.empty())
+    {
+        EGTLOG_DEBUG("setting m_size to {} from {}", size, m_size);
+        m_size = size;
+    }
+}
+
+void GstAppSinkImpl::take(GstSample* sample)
+{
+    if (m_videosample)
+    {
+        // replaced before it was drawn, like when the window is hidden
+        if (m_fresh)
+            m_mailbox.mark_dropped();
+        gst_sample_unref(m_videosample);
     }
+
+    m_videosample = sample;
+    m_fresh = true;
+    m_interface.damage();
+}
+
+GstAppSinkImpl::~GstAppSinkImpl() noexcept
+{
+    if (m_videosample)
+        gst_sample_unref(m_videosample);
 }
 
 gboolean GstAppSinkImpl::post_position(gpointer data)
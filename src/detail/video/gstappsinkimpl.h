@@ -7,6 +7,8 @@
 #define EGT_SRC_DETAIL_VIDEO_GSTAPPSINKIMPL_H
 
 #include "detail/video/gstdecoderimpl.h"
+#include "detail/video/gstsamplemailbox.h"
+#include "egt/types.h"
 #include <gst/app/gstappsink.h>
 #include <string>
 
@@ -32,11 +34,34 @@ public:
 
     void resize(const Size& size) override;
 
+    uint64_t frames_decoded() const override { return m_mailbox.decoded(); }
+
+    uint64_t frames_dropped() const override { return m_mailbox.dropped(); }
+
+    uint64_t frames_displayed() const override { return m_mailbox.displayed(); }
+
+    ~GstAppSinkImpl() noexcept override;
+
 protected:
     GstElement* m_appsink;
 
     GstSample* m_videosample{nullptr};
 
+    /// Whether m_videosample was not drawn yet.
+    bool m_fresh{false};
+
+    /// Newest sample from the streaming thread.
+    SampleMailbox m_mailbox;
+
+    /// Format of the frames the appsink delivers without a plane.
+    PixelFormat m_format{PixelFormat::rgb565};
+
+    /// Size last put in the caps of the video capsfilter.
+    Size m_caps_size;
+
+    /// Take the newest sample, on the event loop thread.
+    void take(GstSample* sample);
+
     static GstFlowReturn on_new_buffer(GstElement* elt, gpointer data);
 
     static gboolean post_position(gpointer data);
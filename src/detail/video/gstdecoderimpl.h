@@ -72,6 +72,12 @@ public:
 
     virtual bool has_audio() const;
 
+    virtual uint64_t frames_decoded() const { return 0; }
+
+    virtual uint64_t frames_dropped() const { return 0; }
+
+    virtual uint64_t frames_displayed() const { return 0; }
+
     virtual void destroyPipeline();
 
     virtual ~GstDecoderImpl();
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/video/gstsamplemailbox.h"
+#include "egt/app.h"
+#include "egt/eventloop.h"
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+SampleMailbox::SampleMailbox(Handler handler)
+    : m_slot(std::make_shared<Slot>())
+{
+    m_slot->handler = std::move(handler);
+}
+
+void SampleMailbox::put(GstSample* sample)
+{
+    mark_decoded();
+
+    auto old = m_slot->sample.exchange(sample, std::memory_order_acq_rel);
+    if (old)
+    {
+        gst_sample_unref(old);
+        mark_dropped();
+    }
+
+    if (m_slot->posted.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    if (!Application::check_instance())
+    {
+        m_slot->posted.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    auto slot = m_slot;
+    asio::post(Application::instance().event().io(), [slot]()
+    {
+        // a sample put from now on needs another handler
+        slot->posted.store(false, std::memory_order_release);
+
+        auto sample = slot->sample.exchange(nullptr, std::memory_order_acq_rel);
+        if (!sample)
+            return;
+
+        if (slot->handler)
+            slot->handler(sample);
+        else
+            gst_sample_unref(sample);
+    });
+}
+
+SampleMailbox::~SampleMailbox() noexcept
+{
+    m_slot->handler = nullptr;
+
+    auto sample = m_slot->sample.exchange(nullptr, std::memory_order_acq_rel);
+    if (sample)
+        gst_sample_unref(sample);
+}
+
+} // end of namespace detail
+
+} // end of namespace v1
+
+} // end of namespace egt
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef EGT_SRC_DETAIL_VIDEO_GSTSAMPLEMAILBOX_H
+#define EGT_SRC_DETAIL_VIDEO_GSTSAMPLEMAILBOX_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <gst/gst.h>
+#include <memory>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+/**
+ * Hands the newest sample of a streaming thread to the event loop.
+ *
+ * The mailbox holds one sample.  put() never blocks: a sample that was not
+ * taken yet is replaced and counted as dropped, so the event loop never
+ * works through a backlog of stale frames.  The first put() after the event
+ * loop took the sample posts one handler to it, which means at most one
+ * sample is taken for each frame the event loop draws.
+ *
+ * The mailbox must be created and destroyed on the event loop thread, and
+ * nothing may be put after it is destroyed.
+ */
+class SampleMailbox
+{
+public:
+
+    /// Takes a sample on the event loop thread, with its reference.
+    using Handler = std::function<void(GstSample* sample)>;
+
+    explicit SampleMailbox(Handler handler);
+
+    SampleMailbox(const SampleMailbox&) = delete;
+    SampleMailbox& operator=(const SampleMailbox&) = delete;
+    SampleMailbox(SampleMailbox&&) = delete;
+    SampleMailbox& operator=(SampleMailbox&&) = delete;
+
+    /**
+     * Replace the sample in the mailbox, from the streaming thread.
+     *
+     * This takes the reference of the sample, and counts it as decoded.
+     */
+    void put(GstSample* sample);
+
+    /// Count a sample that did not go through the mailbox as decoded.
+    void mark_decoded() { m_decoded.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Count a sample as dropped.
+    void mark_dropped() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Count a sample as displayed.
+    void mark_displayed() { m_displayed.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Number of samples decoded.
+    uint64_t decoded() const { return m_decoded.load(std::memory_order_relaxed); }
+
+    /// Number of samples decoded but never displayed.
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    /// Number of samples displayed.
+    uint64_t displayed() const { return m_displayed.load(std::memory_order_relaxed); }
+
+    ~SampleMailbox() noexcept;
+
+protected:
+
+    /// State shared with the posted handler.
+    struct Slot
+    {
+        /// The newest sample, or nullptr.
+        std::atomic<GstSample*> sample{nullptr};
+        /// A handler to take the sample is posted to the event loop.
+        std::atomic<bool> posted{false};
+        /// Takes the sample, or empty once the mailbox is destroyed.
+        Handler handler;
+    };
+
+    /// State shared with the posted handler.
+    std::shared_ptr<Slot> m_slot;
+
+    std::atomic<uint64_t> m_decoded{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_displayed{0};
+};
+
+} // end of namespace detail
+
+} // end of namespace v1
+
+} // end of namespace egt
+
+#endif
@@ -10,12 +10,20 @@
 #include "detail/egtlog.h"
 #include "egt/canvas.h"
 #include "egt/detail/enum.h"
+#include "egt/detail/filesystem.h"
+#include "egt/detail/string.h"
 #include "egt/font.h"
+#include "egt/resource.h"
 #include "egt/respath.h"
 #include "egt/serialize.h"
 #include <cairo-ft.h>
+#include <cstdlib>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <sstream>
+#include <tuple>
+#include <vector>
 
 namespace egt
 {
@@ -43,83 +51,115 @@ static bool init_freetype()
     return true;
 }
 
-static void ft_done_face_uncached(void* closure)
-{
-    auto face = static_cast<FT_Face>(closure);
-    FT_Done_Face(face);
-}
+using shared_cairo_font_face_t = std::shared_ptr<cairo_font_face_t>;
 
-static shared_cairo_scaled_font_t create_ft_font(cairo_t* cr,
-        FT_Face& face,
-        const Font& font)
+/// FreeType face owned by a cairo font face.
+struct FtFaceData
 {
-    std::unique_ptr<cairo_font_face_t, decltype(cairo_font_face_destroy)*>
-    font_face(cairo_ft_font_face_create_for_ft_face(face, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP),
-              cairo_font_face_destroy);
+    FtFaceData() = default;
+    FtFaceData(const FtFaceData&) = delete;
+    FtFaceData& operator=(const FtFaceData&) = delete;
 
-    static const cairo_user_data_key_t key{};
-    if (cairo_font_face_set_user_data(font_face.get(), &key, face, ft_done_face_uncached))
-        return nullptr;
-
-    std::unique_ptr<cairo_font_options_t, decltype(cairo_font_options_destroy)*>
-    font_options(cairo_font_options_create(), cairo_font_options_destroy);
-    cairo_get_font_options(cr, font_options.get());
-    cairo_font_options_set_hint_style(font_options.get(), CAIRO_HINT_STYLE_NONE);
-    cairo_font_options_set_hint_metrics(font_options.get(), CAIRO_HINT_METRICS_OFF);
+    ~FtFaceData()
+    {
+        if (face)
+            FT_Done_Face(face);
+    }
 
-    cairo_matrix_t size_matrix{};
-    cairo_matrix_t identity_matrix{};
-    cairo_matrix_init_scale(&size_matrix, font.size(), font.size());
-    cairo_matrix_init_identity(&identity_matrix);
+    FT_Face face{nullptr};
+    /// Copy of the font file, when it can't be referenced where it is.
+    std::vector<unsigned char> data;
+};
 
-    shared_cairo_scaled_font_t scaled_font(cairo_scaled_font_create(font_face.get(),
-                                           &size_matrix,
-                                           &identity_matrix,
-                                           font_options.get()),
-                                           cairo_scaled_font_destroy);
+static shared_cairo_font_face_t create_ft_font_face(std::unique_ptr<FtFaceData> data)
+{
+    shared_cairo_font_face_t font_face(
+        cairo_ft_font_face_create_for_ft_face(data->face, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP),
+        cairo_font_face_destroy);
 
-    if (!scaled_font || cairo_scaled_font_status(scaled_font.get()))
+    // the FT_Face is released with the last scaled font using it
+    static const cairo_user_data_key_t key{};
+    const auto destroy = [](void* closure)
+    {
+        delete static_cast<FtFaceData*>(closure);
+    };
+    if (cairo_font_face_set_user_data(font_face.get(), &key, data.get(), destroy))
         return nullptr;
 
-    return scaled_font;
+    data.release();
+    return font_face;
 }
 
-static shared_cairo_scaled_font_t create_ft_scaled_font(cairo_t* cr,
-        const char* path,
-        const Font& font)
+static shared_cairo_font_face_t create_ft_font_face(const char* path)
 {
-    EGTLOG_DEBUG("allocating font using FreeType: {}", font.face());
+    EGTLOG_DEBUG("opening font using FreeType: {}", path);
 
     if (!init_freetype())
         return nullptr;
 
-    FT_Face face{};
-    FT_Error status = FT_New_Face(ftlib, path, 0, &face);
+    std::unique_ptr<FtFaceData> data(new FtFaceData);
+    FT_Error status = FT_New_Face(ftlib, path, 0, &data->face);
     if (status != 0)
     {
         detail::error("error opening font {}", path);
         return nullptr;
     }
 
-    return create_ft_font(cr, face, font);
+    return create_ft_font_face(std::move(data));
 }
 
-static shared_cairo_scaled_font_t create_ft_scaled_font(cairo_t* cr,
-        const unsigned char* data,
-        size_t len, const Font& font)
+static shared_cairo_font_face_t create_ft_font_face(const unsigned char* buf,
+        size_t len, std::vector<unsigned char> copy = {})
 {
-    EGTLOG_DEBUG("allocating memory font using FreeType: {}", font.face());
+    EGTLOG_DEBUG("opening memory font using FreeType");
 
     if (!init_freetype())
         return nullptr;
 
-    FT_Face face{};
-    FT_Error status = FT_New_Memory_Face(ftlib, static_cast<const FT_Byte*>(data),
-                                         len, 0, &face);
+    std::unique_ptr<FtFaceData> data(new FtFaceData);
+    data->data = std::move(copy);
+    if (!data->data.empty())
+    {
+        buf = data->data.data();
+        len = data->data.size();
+    }
+
+    FT_Error status = FT_New_Memory_Face(ftlib, static_cast<const FT_Byte*>(buf),
+                                         len, 0, &data->face);
     if (status)
         return nullptr;
 
-    return create_ft_font(cr, face, font);
+    return create_ft_font_face(std::move(data));
+}
+
+static shared_cairo_scaled_font_t create_ft_font(cairo_t* cr,
+        const shared_cairo_font_face_t& font_face,
+        const Font& font)
+{
+    if (!font_face)
+        return nullptr;
+
+    std::unique_ptr<cairo_font_options_t, decltype(cairo_font_options_destroy)*>
+    font_options(cairo_font_options_create(), cairo_font_options_destroy);
+    cairo_get_font_options(cr, font_options.get());
+    cairo_font_options_set_hint_style(font_options.get(), CAIRO_HINT_STYLE_NONE);
+    cairo_font_options_set_hint_metrics(font_options.get(), CAIRO_HINT_METRICS_OFF);
+
+    cairo_matrix_t size_matrix{};
+    cairo_matrix_t identity_matrix{};
+    cairo_matrix_init_scale(&size_matrix, font.size(), font.size());
+    cairo_matrix_init_identity(&identity_matrix);
+
+    shared_cairo_scaled_font_t scaled_font(cairo_scaled_font_create(font_face.get(),
+                                           &size_matrix,
+                                           &identity_matrix,
+                                           font_options.get()),
+                                           cairo_scaled_font_destroy);
+
+    if (!scaled_font || cairo_scaled_font_status(scaled_font.get()))
+        return nullptr;
+
+    return scaled_font;
 }
 
 #ifdef HAVE_FONTCONFIG
@@ -314,6 +354,84 @@ struct FontCache : private detail::NonCopyable<FontCache>
 
     std::map<Font, shared_cairo_scaled_font_t, FontCompare> cache;
 
+    /// Font files by resolved path, shared by all sizes of a font.
+    std::map<std::string, shared_cairo_font_face_t> faces;
+
+    using ManifestKey = std::tuple<std::string, Font::Weight, Font::Slant>;
+
+    /// Font files by face name, weight, and slant.
+    std::map<ManifestKey, std::string> manifest;
+
+    bool manifest_loaded{false};
+
+    /// Find the font file of a face name in the manifest.
+    std::string lookup(const Font& font)
+    {
+        if (!manifest_loaded)
+        {
+            manifest_loaded = true;
+            auto env = std::getenv("EGT_FONT_MANIFEST");
+            if (env && strlen(env))
+                Font::load_manifest(env);
+        }
+
+        if (manifest.empty())
+            return {};
+
+        const ManifestKey keys[] =
+        {
+            ManifestKey{font.face(), font.weight(), font.slant()},
+            ManifestKey{font.face(), font.weight(), Font::Slant::normal},
+            ManifestKey{font.face(), Font::Weight::normal, Font::Slant::normal},
+        };
+
+        for (const auto& key : keys)
+        {
+            auto i = manifest.find(key);
+            if (i != manifest.end())
+                return i->second;
+        }
+
+        return {};
+    }
+
+    shared_cairo_font_face_t font_face(detail::SchemeType type, const std::string& path)
+    {
+        const auto key = (type == detail::SchemeType::resource ? "res:" : "") + path;
+        auto i = faces.find(key);
+        if (i != faces.end())
+            return i->second;
+
+        shared_cairo_font_face_t face;
+        if (type == detail::SchemeType::resource)
+        {
+            auto& rm = ResourceManager::instance();
+            if (!rm.exists(path.c_str()))
+                throw std::runtime_error("font resource not found: " + path);
+
+            // mapped and registered resources are referenced in place
+            if (rm.compressed(path.c_str()))
+            {
+                std::vector<unsigned char> copy(rm.size(path.c_str()));
+                rm.read(path.c_str(), copy.data(), copy.size());
+                face = create_ft_font_face(nullptr, 0, std::move(copy));
+            }
+            else
+            {
+                face = create_ft_font_face(rm.data(path.c_str()),
+                                           rm.size(path.c_str()));
+            }
+        }
+        else
+        {
+            face = create_ft_font_face(path.c_str());
+        }
+
+        if (face)
+            faces.insert(std::make_pair(key, face));
+        return face;
+    }
+
     shared_cairo_scaled_font_t scaled_font(const Font& font)
     {
         auto i = cache.find(font);
@@ -327,14 +445,19 @@ struct FontCache : private detail::NonCopyable<FontCache>
 
         shared_cairo_scaled_font_t scaled_font;
 
+        auto uri = lookup(font);
+        if (uri.empty())
+            uri = font.face();
+
         std::string path;
-        auto type = detail::resolve_path(font.face(), path);
+        auto type = detail::resolve_path(uri, path);
 
         switch (type)
         {
         case detail::SchemeType::filesystem:
+        case detail::SchemeType::resource:
         {
-            scaled_font = create_ft_scaled_font(cr.get(), path.c_str(), font);
+            scaled_font = create_ft_font(cr.get(), font_face(type, path), font);
             break;
         }
         case detail::SchemeType::unknown:
@@ -343,8 +466,24 @@ struct FontCache : private detail::NonCopyable<FontCache>
             scaled_font = create_scaled_font(cr.get(), font);
             break;
         }
+#else
+        {
+            // without fontconfig, the closest match is the default face
+            const auto fallback = lookup(Font(Font::DEFAULT_FACE, font.size(),
+                                              font.weight(), font.slant()));
+            if (!fallback.empty())
+            {
+                type = detail::resolve_path(fallback, path);
+                if (type == detail::SchemeType::filesystem ||
+                    type == detail::SchemeType::resource)
+                {
+                    scaled_font = create_ft_font(cr.get(), font_face(type, path), font);
+                    break;
+                }
+            }
+        }
+        // fallthrough
 #endif
-        case detail::SchemeType::resource:
         case detail::SchemeType::network:
         default:
             throw std::runtime_error("unable to load font uri: " + font.face());
@@ -364,7 +503,7 @@ cairo_scaled_font_t* Font::scaled_font() const
     {
         Canvas canvas(egt::Size(100, 100));
         auto cr = canvas.context().get();
-        m_scaled_font = create_ft_scaled_font(cr, m_data, m_len, *this);
+        m_scaled_font = create_ft_font(cr, create_ft_font_face(m_data, m_len), *this);
     }
 
     if (m_scaled_font)
@@ -373,6 +512,69 @@ cairo_scaled_font_t* Font::scaled_font() const
     return font_cache.scaled_font(*this).get();
 }
 
+void Font::add_face(const std::string& face, const std::string& uri,
+                    Font::Weight weight, Font::Slant slant)
+{
+    font_cache.manifest[FontCache::ManifestKey{face, weight, slant}] = uri;
+}
+
+void Font::load_manifest(const std::string& uri)
+{
+    std::string path;
+    std::vector<unsigned char> data;
+    switch (detail::resolve_path(uri, path))
+    {
+    case detail::SchemeType::resource:
+    {
+        auto& rm = ResourceManager::instance();
+        if (!rm.exists(path.c_str()))
+            throw std::runtime_error("font manifest not found: " + uri);
+        data.resize(rm.size(path.c_str()));
+        rm.read(path.c_str(), data.data(), data.size());
+        break;
+    }
+    case detail::SchemeType::filesystem:
+        data = detail::read_file(path);
+        break;
+    default:
+        throw std::runtime_error("unable to load font manifest: " + uri);
+    }
+
+    std::istringstream in(std::string(data.begin(), data.end()));
+    std::string line;
+    size_t number = 0;
+    while (std::getline(in, line))
+    {
+        ++number;
+        line = detail::trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::vector<std::string> tokens;
+        detail::tokenize(line, ',', tokens);
+        if (tokens.size() != 4)
+        {
+            detail::warn("invalid font manifest line {}:{}: {}", uri, number, line);
+            continue;
+        }
+
+        for (auto& token : tokens)
+            token = detail::trim(token);
+
+        // one bad entry only skips that entry
+        try
+        {
+            add_face(tokens[0], tokens[3],
+                     detail::enum_from_string<Font::Weight>(tokens[1].c_str()),
+                     detail::enum_from_string<Font::Slant>(tokens[2].c_str()));
+        }
+        catch (const std::runtime_error& e)
+        {
+            detail::warn("invalid font manifest line {}:{}: {}", uri, number, e.what());
+        }
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const Font& font)
 {
     os << font.face() << ", " << font.size() << ", " <<
@@ -383,6 +585,7 @@ std::ostream& operator<<(std::ostream& os, const Font& font)
 void Font::reset_font_cache()
 {
     font_cache.cache.clear();
+    font_cache.faces.clear();
 }
 
 void Font::shutdown_fonts()
@@ -230,6 +230,125 @@ void Frame::damage(const Rect& rect)
     add_damage(rect);
 }
 
+/// Whether what is drawn behind a widget is a single color.
+static bool solid_background(const Widget* widget)
+{
+    for (; widget; widget = widget->parent())
+    {
+        if (!widget->fill_flags().empty())
+            return widget->color(Palette::ColorId::bg).type() == Pattern::Type::solid;
+    }
+
+    return false;
+}
+
+bool Frame::child_scrollable(const Widget& child, const Rect& rect) const
+{
+    if (!visible() || offscreen_children())
+        return false;
+
+    if (!detail::float_equal(child.alpha(), 1.f))
+        return false;
+
+    // must be all inside where children are drawn
+    if (Rect::intersection(rect, to_child(content_area())) != rect)
+        return false;
+
+    // nothing may be drawn on top of it
+    bool above = false;
+    for (const auto& c : m_children)
+    {
+        if (c.get() == &child)
+        {
+            above = true;
+            continue;
+        }
+
+        if (above && c->visible() && !c->plane_window() &&
+            c->box().intersect(rect))
+            return false;
+    }
+
+    return true;
+}
+
+bool Frame::scroll_damage(const Rect& rect, const Point& delta)
+{
+    // moving the pixels would also move a background that is not uniform
+    if (!solid_background(this))
+        return false;
+
+    return scroll_damage_up(rect, delta);
+}
+
+bool Frame::scroll_damage_from_child(Widget& child, const Rect& rect, const Point& delta)
+{
+    const auto r = to_child(rect);
+    if (r.empty() || !child.visible())
+        return false;
+
+    if (!solid_background(&child) || !child_scrollable(child, r))
+        return false;
+
+    return scroll_damage_up(rect, delta);
+}
+
+bool Frame::scroll_damage_up(const Rect& rect, const Point& delta)
+{
+    if (rect.empty() || !visible())
+        return false;
+
+    if (std::abs(delta.x()) >= rect.width() || std::abs(delta.y()) >= rect.height())
+        return false;
+
+    // work up to the frame with the screen, the same way damage() does
+    Frame* frame = this;
+    auto r = rect;
+    while (!frame->has_screen())
+    {
+        auto parent = frame->parent();
+        if (!parent || !parent->child_scrollable(*frame, r))
+            return false;
+
+        r = frame->to_parent(r);
+        frame = parent;
+    }
+
+    if (frame->m_in_draw)
+        return false;
+
+    auto screen = frame->screen();
+    if (!screen)
+        return false;
+
+    if (Rect::intersection(r, frame->to_child(frame->box())) != r)
+        return false;
+
+    if (!screen->scroll(r, delta))
+        return false;
+
+    // pixels that were going to be drawn again have moved
+    const auto pending = frame->m_damage;
+    for (auto d : pending)
+    {
+        d += delta;
+        frame->add_damage(Rect::intersection(d, r));
+    }
+
+    // damage what is uncovered
+    if (delta.y() > 0)
+        frame->add_damage(Rect(r.x(), r.y(), r.width(), delta.y()));
+    else if (delta.y() < 0)
+        frame->add_damage(Rect(r.x(), r.bottom() + delta.y(), r.width(), -delta.y()));
+
+    if (delta.x() > 0)
+        frame->add_damage(Rect(r.x(), r.y(), delta.x(), r.height()));
+    else if (delta.x() < 0)
+        frame->add_damage(Rect(r.right() + delta.x(), r.y(), -delta.x(), r.height()));
+
+    return true;
+}
+
 void Frame::walk(const WalkCallback& callback, int level)
 {
     if (!callback(this, level))
@@ -18,13 +18,7 @@ Image::Image(const std::string& uri, float scale)
     : m_uri(uri)
 {
     if (!uri.empty())
-    {
-        m_surface = detail::image_cache().get(uri, scale, scale, false);
-        assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
-
-        m_orig_size = Size(std::ceil(cairo_image_surface_get_width(m_surface.get())),
-                           std::ceil(cairo_image_surface_get_height(m_surface.get())));
-    }
+        load_uri(scale, scale);
 }
 
 Image::Image(const std::string& uri,
@@ -32,17 +26,12 @@ Image::Image(const std::string& uri,
     : m_uri(uri)
 {
     if (!uri.empty())
-    {
-        m_surface = detail::image_cache().get(uri, hscale, vscale, false);
-        assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
-
-        m_orig_size = Size(std::ceil(cairo_image_surface_get_width(m_surface.get())),
-                           std::ceil(cairo_image_surface_get_height(m_surface.get())));
-    }
+        load_uri(hscale, vscale);
 }
 
 Image::Image(shared_cairo_surface_t surface)
-    : m_surface(std::move(surface))
+    : m_surface(std::move(surface)),
+      m_opaque(detail::is_opaque(m_surface.get()))
 {
     assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
 
@@ -63,7 +52,8 @@ Image::Image(cairo_surface_t* surface)
 }
 
 Image::Image(const unsigned char* data, size_t len)
-    : m_surface(detail::load_image_from_memory(data, len))
+    : m_surface(detail::load_image_from_memory(data, len)),
+      m_opaque(detail::scan_opaque(m_surface.get()))
 {
     assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
 
@@ -77,16 +67,58 @@ void Image::load(const std::string& uri, float hscale, float vscale)
     {
         if (!uri.empty())
         {
-            m_surface = detail::image_cache().get(uri, hscale, vscale, false);
-            assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
-
-            m_orig_size = Size(std::ceil(cairo_image_surface_get_width(m_surface.get())),
-                               std::ceil(cairo_image_surface_get_height(m_surface.get())));
+            load_uri(hscale, vscale);
             m_pattern.reset();
         }
     }
 }
 
+/*
+ * The scaled size of an image is computed the same way ImageCache scales the
+ * surface, so the size reported before decoding matches the decoded surface.
+ */
+static Size scaled_size(const Size& size, float hscale, float vscale)
+{
+    return {static_cast<DefaultDim>(static_cast<float>(size.width()) * hscale),
+            static_cast<DefaultDim>(static_cast<float>(size.height()) * vscale)};
+}
+
+void Image::load_uri(float hscale, float vscale)
+{
+    m_surface.reset();
+    m_deferred = false;
+    m_source_size = detail::probe_image_size(m_uri);
+
+    if (!m_source_size.empty())
+    {
+        m_deferred = true;
+        m_deferred_hscale = hscale;
+        m_deferred_vscale = vscale;
+        m_deferred_size = scaled_size(m_source_size, hscale, vscale);
+        m_orig_size = m_deferred_size;
+        return;
+    }
+
+    m_surface = detail::image_cache().get(m_uri, hscale, vscale, false);
+    assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
+    m_opaque = detail::is_opaque(m_surface.get());
+
+    m_orig_size = Size(std::ceil(cairo_image_surface_get_width(m_surface.get())),
+                       std::ceil(cairo_image_surface_get_height(m_surface.get())));
+}
+
+void Image::decode() const
+{
+    if (!m_deferred)
+        return;
+
+    m_deferred = false;
+    m_surface = detail::image_cache().get(m_uri, m_deferred_hscale,
+                                          m_deferred_vscale, false);
+    assert(cairo_surface_status(m_surface.get()) == CAIRO_STATUS_SUCCESS);
+    m_opaque = detail::is_opaque(m_surface.get());
+}
+
 void Image::scale(float hscale, float vscale, bool approximate)
 {
     if (m_uri.empty())
@@ -95,7 +127,19 @@ void Image::scale(float hscale, float vscale, bool approximate)
     if (!detail::float_equal(m_hscale, hscale) ||
         !detail::float_equal(m_vscale, vscale))
     {
-        m_surface = detail::image_cache().get(m_uri, hscale, vscale, approximate);
+        // an approximate scale is only known once the cache rounds it
+        if (m_deferred && !approximate)
+        {
+            m_deferred_hscale = hscale;
+            m_deferred_vscale = vscale;
+            m_deferred_size = scaled_size(m_source_size, hscale, vscale);
+        }
+        else
+        {
+            m_deferred = false;
+            m_surface = detail::image_cache().get(m_uri, hscale, vscale, approximate);
+            m_opaque = detail::is_opaque(m_surface.get());
+        }
         m_hscale = hscale;
         m_vscale = vscale;
         m_pattern.reset();
@@ -108,13 +152,15 @@ void Image::copy()
     {
         auto canvas = Canvas(surface());
         m_surface_local = canvas.surface();
+        // the local copy is expected to be modified
+        m_opaque = false;
     }
 }
 
 Image Image::crop(const RectF& rect)
 {
     Canvas canvas(rect.size());
-    canvas.copy(m_surface, rect);
+    canvas.copy(surface(), rect);
     return canvas.surface();
 }
 
@@ -61,7 +61,8 @@ void Label::default_draw(const Label& widget, Painter& painter, const Rect&)
 {
     widget.draw_box(painter, Palette::ColorId::label_bg, Palette::ColorId::border);
 
-    detail::draw_text(painter,
+    detail::draw_text(widget.text_layout(),
+                      painter,
                       widget.content_area(),
                       widget.text(),
                       widget.font(),
@@ -156,7 +157,8 @@ void ImageLabel::default_draw(ImageLabel& widget, Painter& painter, const Rect&
 
         if (!widget.image().empty())
         {
-            detail::draw_text(painter,
+            detail::draw_text(widget.text_layout(),
+                              painter,
                               widget.content_area(),
                               text,
                               widget.font(),
@@ -169,7 +171,8 @@ void ImageLabel::default_draw(ImageLabel& widget, Painter& painter, const Rect&
         }
         else
         {
-            detail::draw_text(painter,
+            detail::draw_text(widget.text_layout(),
+                              painter,
                               widget.content_area(),
                               text,
                               widget.font(),
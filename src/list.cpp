@@ -4,11 +4,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include "egt/detail/imagecache.h"
+#include "egt/detail/math.h"
 #include "egt/frame.h"
 #include "egt/input.h"
 #include "egt/list.h"
 #include "egt/painter.h"
 #include "egt/string.h"
+#include <algorithm>
+#include <cmath>
 
 namespace egt
 {
@@ -240,5 +243,296 @@ void ListBox::deserialize(const std::string& name, const std::string& value,
         Widget::deserialize(name, value, attrs);
 }
 
+constexpr DefaultDim ListView::DEFAULT_ROW_HEIGHT;
+constexpr size_t ListView::ROW_MARGIN;
+
+ListView::ListView(const Rect& rect, size_t count, RowBinder binder) noexcept
+    : Frame(rect),
+      m_binder(std::move(binder)),
+      m_count(count)
+{
+    name("ListView" + std::to_string(m_widgetid));
+
+    // the rows are not drawn past the ends
+    m_kinetic.overscroll(false);
+    m_kinetic.callback([this](const PointF & offset)
+    {
+        update_offset(std::round(offset.y()));
+    });
+
+    fill_flags(Theme::FillFlag::blend);
+    border(theme().default_border());
+
+    update_rows();
+}
+
+ListView::ListView(Frame& parent, const Rect& rect, size_t count, RowBinder binder) noexcept
+    : ListView(rect, count, std::move(binder))
+{
+    parent.add(*this);
+}
+
+void ListView::resize(const Size& s)
+{
+    if (s != size())
+    {
+        Frame::resize(s);
+        update_rows();
+    }
+}
+
+void ListView::layout()
+{
+    // the rows are positioned by update_rows(), not by alignment
+    update_rows();
+}
+
+void ListView::row_count(size_t count)
+{
+    m_count = count;
+    if (m_selected >= static_cast<ssize_t>(count))
+        m_selected = -1;
+    update_rows(true);
+    damage();
+}
+
+void ListView::row_binder(RowBinder binder)
+{
+    m_binder = std::move(binder);
+    update_rows(true);
+}
+
+void ListView::row_factory(RowFactory factory)
+{
+    m_factory = std::move(factory);
+
+    // create all row widgets again
+    for (auto& item : m_pool)
+        remove(item.get());
+    m_pool.clear();
+    m_pool_row.clear();
+    update_rows();
+}
+
+void ListView::row_height(DefaultDim height)
+{
+    if (height > 0 && detail::change_if_diff<>(m_row_height, height))
+    {
+        update_rows();
+        damage();
+    }
+}
+
+void ListView::row_changed(size_t row)
+{
+    if (m_pool.empty())
+        return;
+
+    const auto slot = row % m_pool.size();
+    if (m_pool_row[slot] == static_cast<ssize_t>(row) && m_binder)
+        m_binder(row, *m_pool[slot]);
+}
+
+void ListView::rows_changed()
+{
+    update_rows(true);
+}
+
+void ListView::selected(size_t index)
+{
+    if (index >= m_count)
+        return;
+
+    const auto changed = m_selected != static_cast<ssize_t>(index);
+    m_selected = index;
+
+    if (changed)
+    {
+        for (size_t slot = 0; slot < m_pool.size(); ++slot)
+            m_pool[slot]->checked(m_pool_row[slot] == m_selected);
+
+        damage();
+        on_selected_changed.invoke();
+    }
+
+    on_selected.invoke(index);
+}
+
+ssize_t ListView::row_at(const Point& point) const
+{
+    const auto carea = to_child(content_area());
+    if (!carea.intersect(point))
+        return -1;
+
+    const auto row = (point.y() - carea.y() + m_offset) / m_row_height;
+    if (row < 0 || static_cast<size_t>(row) >= m_count)
+        return -1;
+
+    return row;
+}
+
+DefaultDim ListView::offset_max() const
+{
+    const auto total = static_cast<int64_t>(m_count) * m_row_height;
+    return static_cast<DefaultDim>(std::max<int64_t>(0, total - content_area().height()));
+}
+
+void ListView::offset(DefaultDim offset)
+{
+    m_kinetic.stop();
+    update_offset(offset);
+}
+
+void ListView::update_offset(DefaultDim offset)
+{
+    offset = detail::clamp<DefaultDim>(offset, 0, offset_max());
+    const auto delta = Point(0, m_offset - offset);
+    if (detail::change_if_diff<>(m_offset, offset))
+    {
+        {
+            // rows only move, so don't damage each of them
+            m_scrolling = true;
+            auto reset = detail::on_scope_exit([this]() { m_scrolling = false; });
+            update_rows();
+        }
+
+        if (!scroll_damage(content_area(), delta))
+            damage();
+    }
+}
+
+void ListView::damage_from_child(const Rect& rect)
+{
+    if (m_scrolling)
+        return;
+
+    Frame::damage_from_child(rect);
+}
+
+void ListView::scroll_to(size_t row)
+{
+    if (row >= m_count)
+        return;
+
+    const auto top = static_cast<DefaultDim>(row) * m_row_height;
+    const auto height = content_area().height();
+    if (top < m_offset)
+        offset(top);
+    else if (top + m_row_height > m_offset + height)
+        offset(top + m_row_height - height);
+}
+
+void ListView::update_rows(bool rebind)
+{
+    if (m_in_layout)
+        return;
+
+    m_in_layout = true;
+    auto reset = detail::on_scope_exit([this]() { m_in_layout = false; });
+
+    const auto carea = to_child(content_area());
+    if (carea.empty())
+        return;
+
+    m_offset = detail::clamp<DefaultDim>(m_offset, 0, offset_max());
+
+    // rows that can be partly visible at once, plus a margin on each side
+    const auto visible = static_cast<size_t>(carea.height() / m_row_height + 2);
+    const auto pool_size = visible + 2 * ROW_MARGIN;
+    if (m_pool.size() != pool_size)
+    {
+        while (m_pool.size() > pool_size)
+        {
+            remove(m_pool.back().get());
+            m_pool.pop_back();
+        }
+
+        while (m_pool.size() < pool_size)
+        {
+            auto item = m_factory ? m_factory() : std::make_shared<StringItem>();
+            add(item);
+            m_pool.push_back(std::move(item));
+        }
+
+        // the row of each widget depends on the size of the pool
+        m_pool_row.assign(pool_size, -1);
+    }
+
+    const auto first = static_cast<size_t>(m_offset / m_row_height);
+    const auto start = first > ROW_MARGIN ? first - ROW_MARGIN : 0;
+    const auto end = std::min(m_count, start + pool_size);
+
+    for (size_t slot = 0; slot < pool_size; ++slot)
+    {
+        // the only row in [start, end) that maps to this widget
+        const auto row = start + (slot + pool_size - start % pool_size) % pool_size;
+        auto& item = m_pool[slot];
+
+        if (row >= end)
+        {
+            item->hide();
+            continue;
+        }
+
+        if (rebind || m_pool_row[slot] != static_cast<ssize_t>(row))
+        {
+            if (m_binder)
+                m_binder(row, *item);
+            m_pool_row[slot] = row;
+        }
+
+        item->checked(static_cast<ssize_t>(row) == m_selected);
+        item->box(Rect(carea.x(),
+                       carea.y() + static_cast<DefaultDim>(row) * m_row_height - m_offset,
+                       carea.width(),
+                       m_row_height));
+        item->show();
+    }
+}
+
+void ListView::handle(Event& event)
+{
+    switch (event.id())
+    {
+    case EventId::pointer_click:
+    {
+        const auto row = row_at(display_to_local(event.pointer().point));
+        if (row >= 0)
+            selected(row);
+
+        event.stop();
+        return;
+    }
+    case EventId::pointer_drag_start:
+        m_start_offset = m_offset;
+        m_kinetic.bounds(PointF(), PointF(0, offset_max()));
+        m_kinetic.begin(PointF(0, m_offset));
+        event.stop();
+        return;
+    case EventId::pointer_drag:
+    {
+        const auto diff = event.pointer().point - event.pointer().drag_start;
+        const auto offset = m_kinetic.drag(PointF(0, m_start_offset - diff.y()));
+        update_offset(std::round(offset.y()));
+        event.stop();
+        return;
+    }
+    case EventId::pointer_drag_stop:
+        m_kinetic.release();
+        event.stop();
+        return;
+    case EventId::raw_pointer_down:
+        // touching stops a fling
+        m_kinetic.stop();
+        return;
+    case EventId::raw_pointer_up:
+        return;
+    default:
+        break;
+    }
+
+    Frame::handle(event);
+}
+
 }
 }
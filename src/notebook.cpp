@@ -3,8 +3,11 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include "egt/app.h"
+#include "egt/eventloop.h"
 #include "egt/notebook.h"
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 
 namespace egt
@@ -48,7 +51,9 @@ void Notebook::add(const std::shared_ptr<Widget>& widget)
     if (!cell)
         throw std::invalid_argument("only NotebookTab can be added to a Notebook");
 
-    m_cells.push_back(cell);
+    Cell c;
+    c.tab = cell;
+    m_cells.push_back(std::move(c));
 
     widget->align(AlignFlag::expand);
 
@@ -57,6 +62,7 @@ void Notebook::add(const std::shared_ptr<Widget>& widget)
     if (m_selected < 0)
     {
         m_selected = 0;
+        m_cells.front().used = ++m_clock;
         widget->show();
     }
     else
@@ -67,6 +73,98 @@ void Notebook::add(const std::shared_ptr<Widget>& widget)
     layout();
 }
 
+size_t Notebook::add_page(PageFactory factory)
+{
+    if (!factory)
+        throw std::invalid_argument("page factory is empty");
+
+    Cell c;
+    c.factory = std::move(factory);
+    m_cells.push_back(std::move(c));
+
+    const auto index = m_cells.size() - 1;
+    if (m_selected < 0)
+    {
+        auto tab = build(index);
+        if (tab)
+        {
+            m_selected = index;
+            m_cells[index].used = ++m_clock;
+            tab->show();
+        }
+    }
+
+    return index;
+}
+
+std::shared_ptr<NotebookTab> Notebook::build(size_t index)
+{
+    auto& cell = m_cells[index];
+    auto tab = cell.tab.lock();
+    if (tab || !cell.factory)
+        return tab;
+
+    tab = cell.factory();
+    if (!tab)
+        return nullptr;
+
+    tab->align(AlignFlag::expand);
+    tab->hide();
+    Frame::add(tab);
+    cell.tab = tab;
+    layout();
+
+    return tab;
+}
+
+void Notebook::page_budget(size_t pages)
+{
+    m_page_budget = pages;
+    trim();
+}
+
+void Notebook::trim()
+{
+    while (true)
+    {
+        size_t built = 0;
+        Cell* oldest = nullptr;
+        for (size_t i = 0; i < m_cells.size(); ++i)
+        {
+            auto& cell = m_cells[i];
+            if (!cell.factory || static_cast<ssize_t>(i) == m_selected || cell.tab.expired())
+                continue;
+
+            ++built;
+            if (!oldest || cell.used < oldest->used)
+                oldest = &cell;
+        }
+
+        if (built <= m_page_budget)
+            return;
+
+        // the cell keeps the factory, so the page can be built again
+        auto tab = oldest->tab.lock();
+        oldest->tab.reset();
+
+        if (!Application::check_instance())
+        {
+            Frame::remove(tab.get());
+            continue;
+        }
+
+        // The page may be the one being left, from a handler of one of its
+        // own widgets, so it is only removed once back in the event loop.
+        asio::post(Application::instance().event().io(), [tab]()
+        {
+            // the notebook unsets the parent if it is destroyed first
+            auto parent = tab->parent();
+            if (parent)
+                parent->Frame::remove(tab.get());
+        });
+    }
+}
+
 void Notebook::remove(Widget* widget)
 {
     assert(widget);
@@ -74,9 +172,9 @@ void Notebook::remove(Widget* widget)
         return;
 
     auto i = std::remove_if(m_cells.begin(), m_cells.end(),
-                            [widget](const std::weak_ptr<NotebookTab>& cell)
+                            [widget](const Cell & cell)
     {
-        auto w = cell.lock();
+        auto w = cell.tab.lock();
         if (w)
             return w.get() == widget;
         return false;
@@ -107,7 +205,7 @@ void Notebook::selected(size_t index)
         if (m_selected >= 0 &&
             m_selected < static_cast<int>(m_cells.size()))
         {
-            auto from = m_cells[m_selected].lock();
+            auto from = m_cells[m_selected].tab.lock();
             if (from)
             {
                 if (!from->leave())
@@ -117,22 +215,25 @@ void Notebook::selected(size_t index)
         }
 
         m_selected = index;
-        auto to = m_cells[m_selected].lock();
+        m_cells[index].used = ++m_clock;
+        auto to = build(index);
         if (to)
         {
             to->enter();
             to->show();
         }
 
+        trim();
+
         on_selected_changed.invoke();
     }
 }
 
 void Notebook::selected(Widget* widget)
 {
-    auto predicate = [widget](const std::weak_ptr<NotebookTab>& ptr)
+    auto predicate = [widget](const Cell & cell)
     {
-        auto w = ptr.lock();
+        auto w = cell.tab.lock();
         if (w)
             return w.get() == widget;
         return false;
@@ -147,7 +248,7 @@ NotebookTab* Notebook::get(size_t index) const
 {
     if (index < m_cells.size())
     {
-        auto w = m_cells[index].lock();
+        auto w = m_cells[index].tab.lock();
         if (w)
             return w.get();
     }
@@ -3,10 +3,14 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include "detail/fontmetrics.h"
+#include "egt/detail/math.h"
 #include "egt/image.h"
 #include "egt/painter.h"
 #include <cairo.h>
+#include <cmath>
 #include <deque>
+#include <memory>
 
 namespace egt
 {
@@ -75,12 +79,49 @@ Painter& Painter::draw(const Image& image)
     cairo_translate(m_cr.get(), x, y);
     cairo_set_source(m_cr.get(), image.pattern());
 
+    if (opaque_blit(image))
+    {
+        /*
+         * A straight copy, limited to the image itself.  Filling consumes
+         * the path, which paint() does not, so the caller's path is put
+         * back afterwards instead of being filled with the image.
+         */
+        std::unique_ptr<cairo_path_t, decltype(cairo_path_destroy)*>
+        path(cairo_copy_path(m_cr.get()), cairo_path_destroy);
+        cairo_new_path(m_cr.get());
+
+        cairo_set_operator(m_cr.get(), CAIRO_OPERATOR_SOURCE);
+        cairo_rectangle(m_cr.get(), 0, 0, image.width(), image.height());
+        fill();
+
+        if (path && path->status == CAIRO_STATUS_SUCCESS)
+            cairo_append_path(m_cr.get(), path.get());
+        return *this;
+    }
+
     /// @todo no paint here
     paint();
 
     return *this;
 }
 
+bool Painter::opaque_blit(const Image& image) const
+{
+    if (!image.opaque() ||
+        cairo_get_operator(m_cr.get()) != CAIRO_OPERATOR_OVER)
+        return false;
+
+    // only an unscaled, untransformed, pixel aligned copy is exact
+    cairo_matrix_t matrix;
+    cairo_get_matrix(m_cr.get(), &matrix);
+    return detail::float_equal(matrix.xx, 1.) &&
+           detail::float_equal(matrix.yy, 1.) &&
+           detail::float_equal(matrix.xy, 0.) &&
+           detail::float_equal(matrix.yx, 0.) &&
+           detail::float_equal(matrix.x0, std::round(matrix.x0)) &&
+           detail::float_equal(matrix.y0, std::round(matrix.y0));
+}
+
 Painter& Painter::mask(const Image& image, const Point& point)
 {
     cairo_mask_surface(m_cr.get(), image.surface().get(), point.x(), point.y());
@@ -103,6 +144,36 @@ Painter& Painter::draw(const Rect& rect, const Image& image)
     cairo_get_current_point(m_cr.get(), &x, &y);
     cairo_set_source_surface(m_cr.get(), image.surface().get(),
                              x - rect.x(), y - rect.y());
+
+    if (detail::float_equal(x, std::round(x)) &&
+        detail::float_equal(y, std::round(y)) &&
+        Rect(Point(), image.size()).contains(rect) &&
+        opaque_blit(image))
+    {
+        /*
+         * A straight copy, limited to the rectangle.  The rest of the
+         * caller's path is then filled as usual, so nothing outside of the
+         * image is cleared.
+         */
+        std::unique_ptr<cairo_path_t, decltype(cairo_path_destroy)*>
+        path(cairo_copy_path(m_cr.get()), cairo_path_destroy);
+        cairo_new_path(m_cr.get());
+
+        {
+            AutoSaveRestore sr(*this);
+            cairo_set_operator(m_cr.get(), CAIRO_OPERATOR_SOURCE);
+            cairo_rectangle(m_cr.get(), x, y, rect.width(), rect.height());
+            fill();
+        }
+
+        if (path && path->status == CAIRO_STATUS_SUCCESS)
+        {
+            cairo_append_path(m_cr.get(), path.get());
+            fill();
+        }
+        return *this;
+    }
+
     cairo_rectangle(m_cr.get(), x, y, rect.width(), rect.height());
 
     /// @todo no fill here
@@ -121,8 +192,7 @@ Painter& Painter::draw(const std::string& str, const TextDrawFlags& flags)
 
     double x;
     double y;
-    cairo_text_extents_t textext;
-    cairo_text_extents(m_cr.get(), str.c_str(), &textext);
+    const auto textext = detail::FontMetrics::get(cairo_get_scaled_font(m_cr.get())).text_extents(str);
 
     cairo_get_current_point(m_cr.get(), &x, &y);
 
@@ -149,16 +219,14 @@ Painter& Painter::draw(const std::string& str, const TextDrawFlags& flags)
 
 Size Painter::text_size(const std::string& text)
 {
-    cairo_text_extents_t textext;
-    cairo_text_extents(m_cr.get(), text.c_str(), &textext);
+    const auto textext = detail::FontMetrics::get(cairo_get_scaled_font(m_cr.get())).text_extents(text);
     return {static_cast<Size::DimType>(std::floor(textext.width + 1.0)),
             static_cast<Size::DimType>(std::floor(textext.height + 1.0))};
 }
 
 Size Painter::font_size(const std::string& text)
 {
-    cairo_font_extents_t fe;
-    cairo_font_extents(m_cr.get(), &fe);
+    const auto& fe = detail::FontMetrics::get(cairo_get_scaled_font(m_cr.get())).font_extents();
     return {text_size(text).width(),
             static_cast<Size::DimType>(std::floor(fe.height + 1.0))};
 }
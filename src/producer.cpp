@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "egt/app.h"
+#include "egt/eventloop.h"
+#include "egt/producer.h"
+#include "egt/streamchart.h"
+#include <stdexcept>
+
+namespace egt
+{
+inline namespace v1
+{
+namespace detail
+{
+
+struct ProducerBase::Link
+{
+    /// A handler to take what was pushed is posted to the event loop.
+    std::atomic<bool> posted{false};
+    /// The producer, or nullptr once it is destroyed.
+    ProducerBase* owner{nullptr};
+};
+
+ProducerBase::ProducerBase()
+    : m_link(std::make_shared<Link>())
+{
+    m_link->owner = this;
+}
+
+void ProducerBase::schedule()
+{
+    // Pairs with the fence in the handler: either the handler sees what was
+    // pushed before this, or this sees that a new handler is needed.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_link->posted.exchange(true, std::memory_order_seq_cst))
+        return;
+
+    if (!Application::check_instance())
+    {
+        m_link->posted.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    auto link = m_link;
+    asio::post(Application::instance().event().io(), [link]()
+    {
+        // anything pushed from now on needs another handler
+        link->posted.store(false, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (link->owner)
+            link->owner->drain();
+    });
+}
+
+ProducerBase::~ProducerBase() noexcept
+{
+    m_link->owner = nullptr;
+}
+
+}
+
+constexpr size_t ChartProducer::DEFAULT_CAPACITY;
+
+ChartProducer::ChartProducer(StreamChart& chart, size_t series, size_t capacity)
+    : m_chart(chart),
+      m_series(series),
+      m_uniform(chart.x_step(series) > 0),
+      m_queue(capacity),
+      m_taken(m_queue.capacity())
+{
+    m_x.reserve(m_queue.capacity());
+    m_y.reserve(m_queue.capacity());
+}
+
+bool ChartProducer::push(double x, double y)
+{
+    if (m_uniform)
+        throw std::runtime_error("series has a fixed x step");
+
+    if (!m_queue.push({x, y}))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    schedule();
+    return true;
+}
+
+bool ChartProducer::push(double y)
+{
+    if (!m_uniform)
+        throw std::runtime_error("series needs x for each sample");
+
+    if (!m_queue.push({0, y}))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    schedule();
+    return true;
+}
+
+void ChartProducer::drain()
+{
+    const auto count = m_queue.pop(m_taken.data(), m_taken.size());
+    if (!count)
+        return;
+
+    m_x.clear();
+    m_y.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_x.push_back(m_taken[i].x);
+        m_y.push_back(m_taken[i].y);
+    }
+
+    if (m_uniform)
+        m_chart.append(m_series, m_y.data(), count);
+    else
+        m_chart.append(m_series, m_x.data(), m_y.data(), count);
+}
+
+ChartProducer::~ChartProducer() noexcept = default;
+
+}
+}
@@ -8,12 +8,22 @@
 #endif
 
 #include "detail/egtlog.h"
+#include "detail/respack.h"
+#include "egt/detail/filesystem.h"
 #include "egt/detail/image.h"
 #include "egt/detail/meta.h"
 #include "egt/resource.h"
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
+#if defined(HAVE_MMAP) && !defined(WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef HAVE_ZLIB
 #include <zlib.h>
 #endif
@@ -26,10 +36,21 @@ inline namespace v1
 // NOLINTNEXTLINE(hicpp-special-member-functions, cppcoreguidelines-special-member-functions)
 struct ResourceManager::ResourceItem
 {
+    enum class Encoding
+    {
+        unknown,
+        raw,
+        compressed,
+    };
+
     ResourceItem() = delete;
 
-    ResourceItem(const unsigned char* data, size_t len) noexcept
-        : m_data(data),
+    ResourceItem(const unsigned char* data, size_t len,
+                 Encoding encoding = Encoding::unknown,
+                 size_t raw_size = 0) noexcept
+        : encoding(encoding),
+          raw_size(raw_size),
+          m_data(data),
           m_len(len)
     {}
 
@@ -40,7 +61,9 @@ struct ResourceManager::ResourceItem
     {}
 
     ResourceItem(const ResourceItem& rhs)
-        : m_data_copy(rhs.m_data_copy)
+        : encoding(rhs.encoding),
+          raw_size(rhs.raw_size),
+          m_data_copy(rhs.m_data_copy)
     {
         if (!m_data_copy.empty())
         {
@@ -58,140 +81,433 @@ struct ResourceManager::ResourceItem
     ResourceItem(ResourceItem&&) = default;
     ResourceItem& operator=(ResourceItem&&) = default;
 
-    inline const unsigned char* data()
+    /// Data as it should be used, inflated if it is cached.
+    inline const unsigned char* data() const
     {
-        do_inflate();
-        return m_data;
+        return cached ? m_buf.data() : m_data;
     }
 
-    inline size_t len()
+    /// Length of data().
+    inline size_t len() const
     {
-        do_inflate();
-        return m_len;
+        return cached ? m_buf.size() : m_len;
     }
 
+    /// Data as registered, possibly compressed.
+    inline const unsigned char* stored_data() const { return m_data; }
+
+    /// Length of stored_data().
+    inline size_t stored_len() const { return m_len; }
+
     size_t index{0};
 
+    Encoding encoding{Encoding::unknown};
+
+    /// Inflated size if known ahead of time, otherwise 0.
+    size_t raw_size{0};
+
+    /// Inflated copy of the data, only valid if cached.
+    std::vector<unsigned char> m_buf;
+
+    /// True if m_buf holds the inflated data and the item is in the LRU.
+    bool cached{false};
+
+    /// Position in ResourceManager::m_lru, only valid if cached.
+    std::list<ResourceItem*>::iterator lru;
+
 private:
 
-    void do_inflate()
+    std::vector<unsigned char> m_data_copy;
+    const unsigned char* m_data{nullptr};
+    size_t m_len{0};
+};
+
+// NOLINTNEXTLINE(hicpp-special-member-functions, cppcoreguidelines-special-member-functions)
+struct ResourceManager::Pack
+{
+    explicit Pack(const std::string& path)
     {
-#ifdef HAVE_ZLIB
-        if (m_inflated)
-            return;
-        m_inflated = true;
-
-        auto mimetype = detail::get_mime_type(m_data, m_len);
-        if (mimetype != "application/gzip")
-            return;
-
-        z_stream stream{};
-        stream.zalloc = Z_NULL;
-        stream.zfree = Z_NULL;
-        stream.opaque = Z_NULL;
-        if (inflateInit2(&stream, 15 + 32) != Z_OK)
+#if defined(HAVE_MMAP) && !defined(WIN32)
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("unable to open resource pack: " + path);
+
+        struct stat st {};
+        if (::fstat(fd, &st) < 0 || st.st_size <= 0)
         {
-            detail::warn("failed to init zlib inflate");
-            return;
+            ::close(fd);
+            throw std::runtime_error("unable to stat resource pack: " + path);
         }
 
-        stream.next_in = (Bytef*)m_data;
-        stream.avail_in = m_len;
+        m_len = static_cast<size_t>(st.st_size);
+        void* map = ::mmap(nullptr, m_len, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED)
+            throw std::runtime_error("unable to map resource pack: " + path);
+        m_base = static_cast<const unsigned char*>(map);
+        m_mapped = true;
+#else
+        m_buf = detail::read_file(path);
+        m_base = m_buf.data();
+        m_len = m_buf.size();
+#endif
+
+        detail::respack::PackHeader header{};
+        if (m_len >= sizeof(header))
+            memcpy(&header, m_base, sizeof(header));
 
-        const size_t BUFSIZE = 8 * 1024;
-        unsigned char buffer[BUFSIZE];
-        int res;
-        do
+        if (header.magic != detail::respack::MAGIC ||
+            header.version != detail::respack::VERSION ||
+            (m_len - sizeof(header)) / sizeof(detail::respack::PackEntry) < header.count)
         {
-            stream.next_out = reinterpret_cast<Bytef*>(buffer);
-            stream.avail_out = BUFSIZE;
+            unmap();
+            throw std::runtime_error("invalid resource pack: " + path);
+        }
 
-            res = inflate(&stream, Z_NO_FLUSH);
+        m_count = header.count;
+        m_entries = reinterpret_cast<const detail::respack::PackEntry*>(m_base + sizeof(header));
+    }
 
-            if (m_buf.size() < stream.total_out)
-                m_buf.insert(m_buf.end(),
-                             buffer,
-                             buffer + stream.total_out - m_buf.size());
+    Pack(const Pack&) = delete;
+    Pack& operator=(const Pack&) = delete;
 
-        } while (res == Z_OK);
+    ~Pack() noexcept
+    {
+        unmap();
+    }
 
-        inflateEnd(&stream);
+    /// Binary search the index for name, returning nullptr if not found.
+    const detail::respack::PackEntry* find(const char* name) const
+    {
+        const auto len = strlen(name);
+        const auto hash = detail::respack::hash(name, len);
 
-        if (res != Z_STREAM_END)
+        size_t lo = 0;
+        size_t hi = m_count;
+        while (lo < hi)
         {
-            detail::warn("failed to finish zlib inflate: {}", res);
-            return;
+            const auto mid = lo + (hi - lo) / 2;
+            const auto& entry = m_entries[mid];
+            if (!in_bounds(entry.name_offset, entry.name_len))
+                return nullptr;
+
+            const auto r = detail::respack::compare(hash, name, len, entry,
+                                                    entry_name(entry));
+            if (r == 0)
+                return in_bounds(entry.offset, entry.size) ? &entry : nullptr;
+            if (r < 0)
+                hi = mid;
+            else
+                lo = mid + 1;
         }
 
-        m_data = m_buf.data();
-        m_len = m_buf.size();
-        m_data_copy.clear();
+        return nullptr;
+    }
+
+    inline const char* entry_name(const detail::respack::PackEntry& entry) const
+    {
+        return reinterpret_cast<const char*>(m_base + entry.name_offset);
+    }
+
+    inline const unsigned char* entry_data(const detail::respack::PackEntry& entry) const
+    {
+        return m_base + entry.offset;
+    }
+
+    inline bool in_bounds(uint64_t offset, uint64_t len) const
+    {
+        return offset <= m_len && len <= m_len - offset;
+    }
+
+    ResourceManager::ItemArray list() const
+    {
+        ResourceManager::ItemArray names;
+        names.reserve(m_count);
+        for (uint32_t x = 0; x < m_count; ++x)
+        {
+            const auto& entry = m_entries[x];
+            if (in_bounds(entry.name_offset, entry.name_len))
+                names.emplace_back(entry_name(entry), entry.name_len);
+        }
+        return names;
+    }
+
+private:
+
+    void unmap()
+    {
+#if defined(HAVE_MMAP) && !defined(WIN32)
+        if (m_mapped)
+            ::munmap(const_cast<unsigned char*>(m_base), m_len);
+        m_mapped = false;
 #endif
     }
 
-    std::vector<unsigned char> m_data_copy;
-    const unsigned char* m_data{nullptr};
+    const unsigned char* m_base{nullptr};
     size_t m_len{0};
+    const detail::respack::PackEntry* m_entries{nullptr};
+    uint32_t m_count{0};
+#if defined(HAVE_MMAP) && !defined(WIN32)
+    bool m_mapped{false};
+#else
     std::vector<unsigned char> m_buf;
-#ifdef HAVE_ZLIB
-    bool m_inflated {false};
 #endif
 };
 
+#ifdef HAVE_ZLIB
+static bool inflate_data(const unsigned char* data, size_t len, size_t hint,
+                         std::vector<unsigned char>& out)
+{
+    z_stream stream{};
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    // 15 + 32 to automatically detect a zlib or gzip header
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+        detail::warn("failed to init zlib inflate");
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = len;
+
+    if (hint)
+        out.reserve(hint);
+
+    const size_t BUFSIZE = 8 * 1024;
+    unsigned char buffer[BUFSIZE];
+    int res;
+    do
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = BUFSIZE;
+
+        res = inflate(&stream, Z_NO_FLUSH);
+
+        if (out.size() < stream.total_out)
+            out.insert(out.end(),
+                       buffer,
+                       buffer + stream.total_out - out.size());
+
+    } while (res == Z_OK);
+
+    inflateEnd(&stream);
+
+    if (res != Z_STREAM_END)
+    {
+        detail::warn("failed to finish zlib inflate: {}", res);
+        return false;
+    }
+
+    return true;
+}
+#endif
+
 ResourceManager::ResourceManager() = default;
 
+ResourceManager::~ResourceManager() noexcept = default;
+
 ResourceManager& ResourceManager::instance()
 {
     static const std::unique_ptr<ResourceManager> i(new ResourceManager());
     return *i;
 }
 
+ResourceManager::ResourceItem* ResourceManager::find(const char* name)
+{
+    const auto i = m_resources.find(name);
+    if (i != m_resources.end())
+        return &i->second;
+
+    for (auto& pack : m_packs)
+    {
+        const auto entry = pack->find(name);
+        if (entry)
+        {
+            const auto encoding = (entry->flags & detail::respack::FLAG_ZLIB) ?
+                                  ResourceItem::Encoding::compressed :
+                                  ResourceItem::Encoding::raw;
+            auto r = m_resources.emplace(name,
+                                         ResourceItem(pack->entry_data(*entry),
+                                                 entry->size,
+                                                 encoding,
+                                                 entry->raw_size));
+            return &r.first->second;
+        }
+    }
+
+    return nullptr;
+}
+
+void ResourceManager::resolve(ResourceItem& item)
+{
+    if (item.encoding == ResourceItem::Encoding::unknown)
+    {
+        const auto mimetype = detail::get_mime_type(item.stored_data(), item.stored_len());
+        item.encoding = (mimetype == "application/gzip") ?
+                        ResourceItem::Encoding::compressed :
+                        ResourceItem::Encoding::raw;
+    }
+
+    if (item.encoding != ResourceItem::Encoding::compressed)
+        return;
+
+    if (item.cached)
+    {
+        m_lru.splice(m_lru.begin(), m_lru, item.lru);
+        return;
+    }
+
+#ifdef HAVE_ZLIB
+    std::vector<unsigned char> buf;
+    if (!inflate_data(item.stored_data(), item.stored_len(), item.raw_size, buf))
+    {
+        // fall back to handing out the data as-is
+        item.encoding = ResourceItem::Encoding::raw;
+        return;
+    }
+
+    item.m_buf = std::move(buf);
+    item.cached = true;
+    item.lru = m_lru.insert(m_lru.begin(), &item);
+    m_cache_size += item.m_buf.size();
+    trim(&item);
+#else
+    detail::warn("zlib support not available to inflate resource");
+    item.encoding = ResourceItem::Encoding::raw;
+#endif
+}
+
+void ResourceManager::trim(const ResourceItem* keep)
+{
+    while (m_cache_size > m_cache_limit && !m_lru.empty())
+    {
+        auto item = m_lru.back();
+        if (item == keep)
+            break;
+        uncache(*item);
+    }
+}
+
+void ResourceManager::uncache(ResourceItem& item)
+{
+    if (!item.cached)
+        return;
+
+    m_lru.erase(item.lru);
+    m_cache_size -= item.m_buf.size();
+    std::vector<unsigned char>().swap(item.m_buf);
+    item.cached = false;
+}
+
+void ResourceManager::cache_limit(size_t bytes)
+{
+    m_cache_limit = bytes;
+    trim(nullptr);
+}
+
+void ResourceManager::evict()
+{
+    while (!m_lru.empty())
+        uncache(*m_lru.front());
+}
+
 bool ResourceManager::exists(const char* name) const
 {
     const auto i = m_resources.find(name);
-    return i != m_resources.end();
+    if (i != m_resources.end())
+        return true;
+
+    for (auto& pack : m_packs)
+        if (pack->find(name))
+            return true;
+
+    return false;
 }
 
 void ResourceManager::clear()
 {
+    evict();
     m_resources.clear();
+    m_packs.clear();
 }
 
 void ResourceManager::clear(const char* name)
 {
     const auto i = m_resources.find(name);
     if (i != m_resources.end())
+    {
+        uncache(i->second);
         m_resources.erase(i);
+    }
 }
 
 size_t ResourceManager::size(const char* name)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
-        return i->second.len();
+    auto item = find(name);
+    if (item)
+    {
+        // pack entries know their inflated size without inflating
+        if (item->encoding == ResourceItem::Encoding::compressed &&
+            !item->cached && item->raw_size)
+            return item->raw_size;
+
+        resolve(*item);
+        return item->len();
+    }
 
     return 0;
 }
 
 const unsigned char* ResourceManager::data(const char* name)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
-        return i->second.data();
+    auto item = find(name);
+    if (item)
+    {
+        resolve(*item);
+        return item->data();
+    }
+
+    return nullptr;
+}
+
+const unsigned char* ResourceManager::stored_data(const char* name, size_t& len)
+{
+    auto item = find(name);
+    if (item)
+    {
+        len = item->stored_len();
+        return item->stored_data();
+    }
 
+    len = 0;
     return nullptr;
 }
 
+bool ResourceManager::compressed(const char* name)
+{
+    auto item = find(name);
+    if (item)
+    {
+        resolve(*item);
+        return item->encoding == ResourceItem::Encoding::compressed;
+    }
+
+    return false;
+}
+
 bool ResourceManager::read(const char* name, unsigned char* data,
                            size_t length, size_t offset)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
+    auto item = find(name);
+    if (item)
     {
-        if ((offset + length) > i->second.len())
+        resolve(*item);
+        if ((offset + length) > item->len())
             throw std::runtime_error("out of bounds read on resource");
 
-        memcpy(data, i->second.data() + offset, length);
+        memcpy(data, item->data() + offset, length);
         return true;
     }
 
@@ -200,22 +516,23 @@ bool ResourceManager::read(const char* name, unsigned char* data,
 
 void ResourceManager::stream_reset(const char* name)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
-        i->second.index = 0;
+    auto item = find(name);
+    if (item)
+        item->index = 0;
 }
 
 bool ResourceManager::stream_read(const char* name, unsigned char* data,
                                   size_t length)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
+    auto item = find(name);
+    if (item)
     {
-        if ((i->second.index + length) > i->second.len())
+        resolve(*item);
+        if ((item->index + length) > item->len())
             throw std::runtime_error("read past end of data on resource");
 
-        memcpy(data, i->second.data() + i->second.index, length);
-        i->second.index += length;
+        memcpy(data, item->data() + item->index, length);
+        item->index += length;
 
         return true;
     }
@@ -235,7 +552,19 @@ std::vector<T1> extract_keys(std::map<T1, T2> const& input_map)
 
 ResourceManager::ItemArray ResourceManager::list() const
 {
-    return extract_keys(m_resources);
+    auto ret = extract_keys(m_resources);
+    if (m_packs.empty())
+        return ret;
+
+    for (auto& pack : m_packs)
+    {
+        auto names = pack->list();
+        ret.insert(ret.end(), names.begin(), names.end());
+    }
+
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    return ret;
 }
 
 void ResourceManager::add(const char* name, const unsigned char* data, size_t len)
@@ -256,11 +585,14 @@ void ResourceManager::add(const char* name, const std::vector<unsigned char>& da
     m_resources.insert(std::make_pair(name, r));
 }
 
+void ResourceManager::add_pack(const std::string& path)
+{
+    m_packs.emplace_back(std::make_unique<Pack>(path));
+}
+
 void ResourceManager::remove(const char* name)
 {
-    const auto i = m_resources.find(name);
-    if (i != m_resources.end())
-        m_resources.erase(i);
+    clear(name);
 }
 
 namespace detail
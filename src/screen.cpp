@@ -36,7 +36,11 @@ Screen::Screen() noexcept
 
 void Screen::flip(const DamageArray& damage)
 {
-    if (!damage.empty() && index() < m_buffers.size())
+    if (index() >= m_buffers.size())
+        return;
+
+    // scroll() may have left damage on the buffers without any drawing
+    if (!damage.empty() || !m_buffers[index()].damage.empty())
     {
         // save the damage to all buffers
         for (auto& b : m_buffers)
@@ -64,6 +68,64 @@ void Screen::flip(const DamageArray& damage)
     }
 }
 
+bool Screen::scroll(const Rect& rect, const Point& delta)
+{
+    if (!m_surface)
+        return false;
+
+    size_t bpp;
+    switch (cairo_image_surface_get_format(m_surface.get()))
+    {
+    case CAIRO_FORMAT_RGB16_565:
+        bpp = 2;
+        break;
+    case CAIRO_FORMAT_ARGB32:
+    case CAIRO_FORMAT_RGB24:
+        bpp = 4;
+        break;
+    default:
+        return false;
+    }
+
+    const auto r = Rect::intersection(rect, box());
+    auto dst = r;
+    dst += delta;
+    dst = Rect::intersection(dst, r);
+    if (dst.empty())
+        return true;
+
+    cairo_surface_flush(m_surface.get());
+    auto data = cairo_image_surface_get_data(m_surface.get());
+    const auto stride = cairo_image_surface_get_stride(m_surface.get());
+    const auto bytes = dst.width() * bpp;
+
+    const auto move_row = [&](DefaultDim y)
+    {
+        memmove(data + y * stride + dst.x() * bpp,
+                data + (y - delta.y()) * stride + (dst.x() - delta.x()) * bpp,
+                bytes);
+    };
+
+    // copy rows in the direction that does not overwrite rows not yet copied
+    if (delta.y() > 0)
+    {
+        for (auto y = dst.bottom() - 1; y >= dst.top(); --y)
+            move_row(y);
+    }
+    else
+    {
+        for (auto y = dst.top(); y < dst.bottom(); ++y)
+            move_row(y);
+    }
+
+    cairo_surface_mark_dirty(m_surface.get());
+
+    for (auto& b : m_buffers)
+        b.add_damage(dst);
+
+    return true;
+}
+
 #ifdef HAVE_SIMD
 
 using View = Simd::View<Simd::Allocator>;
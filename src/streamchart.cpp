@@ -0,0 +1,600 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fmt.h"
+#include "detail/fontmetrics.h"
+#include "egt/frame.h"
+#include "egt/painter.h"
+#include "egt/streamchart.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace egt
+{
+inline namespace v1
+{
+
+constexpr size_t StreamChart::DEFAULT_CAPACITY;
+
+/// Widest label, used to reserve room for labels whatever the range.
+static const char* const WIDEST_LABEL = "-8.888e+88";
+
+static std::string format_label(double value)
+{
+    return fmt::format("{:.4g}", value);
+}
+
+StreamChart::StreamChart(const Rect& rect) noexcept
+    : Widget(rect)
+{
+    name("StreamChart" + std::to_string(m_widgetid));
+
+    border(theme().default_border());
+    fill_flags(Theme::FillFlag::blend);
+    padding(5);
+}
+
+StreamChart::StreamChart(Frame& parent, const Rect& rect) noexcept
+    : StreamChart(rect)
+{
+    parent.add(*this);
+}
+
+size_t StreamChart::add_series(const Color& color, size_t capacity, SampleFormat format)
+{
+    m_series.emplace_back(color, capacity, format, 0.0, 0.0);
+    m_columns_width = 0;
+    damage();
+    return m_series.size() - 1;
+}
+
+size_t StreamChart::add_uniform_series(const Color& color, double x0, double step,
+                                       size_t capacity, SampleFormat format)
+{
+    if (!(step > 0))
+        throw std::runtime_error("x step must be positive");
+
+    m_series.emplace_back(color, capacity, format, x0, step);
+    m_columns_width = 0;
+    damage();
+    return m_series.size() - 1;
+}
+
+void StreamChart::append(size_t series, const double* x, const double* y, size_t count)
+{
+    append_samples(series, x, y, count);
+}
+
+void StreamChart::append(size_t series, const double* x, const float* y, size_t count)
+{
+    append_samples(series, x, y, count);
+}
+
+void StreamChart::append(size_t series, const double* y, size_t count)
+{
+    append_samples(series, nullptr, y, count);
+}
+
+void StreamChart::append(size_t series, const float* y, size_t count)
+{
+    append_samples(series, nullptr, y, count);
+}
+
+template<class T>
+void StreamChart::append_samples(size_t series, const double* x, const T* y, size_t count)
+{
+    auto& s = m_series[series];
+    if ((s.step > 0) == (x != nullptr))
+        throw std::runtime_error(s.step > 0 ? "series has a fixed x step" :
+                                 "series needs x for each sample");
+
+    const auto capacity = s.capacity();
+    if (!capacity || !count)
+        return;
+
+    // older samples would be dropped right away
+    if (count > capacity)
+    {
+        const auto skip = count - capacity;
+        if (x)
+            x += skip;
+        y += skip;
+        s.total += skip;
+        count = capacity;
+    }
+
+    if (x)
+        s.x.append(x, count);
+    if (s.format == SampleFormat::float32)
+        s.y32.append(y, count);
+    else
+        s.y64.append(y, count);
+    s.total += count;
+
+    bool range_changed = false;
+    if (m_columns_width)
+    {
+        bool check = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto xi = x ? x[i] :
+                            s.x0 + static_cast<double>(s.total - count + i) * s.step;
+            if (add_column_sample(s, xi, y[i]))
+                check = true;
+        }
+
+        if (check)
+            range_changed = update_y_range();
+    }
+
+    damage_plot(range_changed);
+}
+
+void StreamChart::clear()
+{
+    for (auto& s : m_series)
+    {
+        s.x.clear();
+        s.y64.clear();
+        s.y32.clear();
+        s.total = 0;
+        s.columns.clear();
+    }
+
+    m_has_columns = false;
+    update_y_range();
+    invalidate_layers();
+    damage();
+}
+
+void StreamChart::capacity(size_t series, size_t capacity)
+{
+    auto& s = m_series[series];
+    if (!(s.step > 0))
+        s.x.capacity(capacity);
+    if (s.format == SampleFormat::float32)
+        s.y32.capacity(capacity);
+    else
+        s.y64.capacity(capacity);
+
+    // columns may hold samples that are gone
+    m_columns_width = 0;
+    damage();
+}
+
+void StreamChart::x_span(double span)
+{
+    if (!(span > 0))
+        throw std::runtime_error("x span must be positive");
+
+    if (detail::change_if_diff<>(m_x_span, span))
+    {
+        m_columns_width = 0;
+        damage();
+    }
+}
+
+void StreamChart::y_range(double min, double max)
+{
+    if (max <= min)
+        throw std::runtime_error("invalid y range");
+
+    m_y_min = min;
+    m_y_max = max;
+    m_y_auto = false;
+    invalidate_layers();
+    damage();
+}
+
+void StreamChart::y_auto()
+{
+    if (detail::change_if_diff<>(m_y_auto, true))
+    {
+        update_y_range();
+        invalidate_layers();
+        damage();
+    }
+}
+
+void StreamChart::damage_plot(bool range_changed)
+{
+    // with cached images, nothing outside of the plot changes with the samples
+    if (m_incremental && !range_changed && !m_plot_area.empty())
+        damage(m_plot_area);
+    else
+        damage();
+}
+
+Rect StreamChart::plot_area() const
+{
+    const auto b = content_area();
+    auto& metrics = detail::FontMetrics::get(font().scaled_font());
+
+    // room for the labels left of and below the plot
+    const auto label_width =
+        static_cast<DefaultDim>(std::ceil(metrics.text_extents(WIDEST_LABEL).x_advance)) + 4;
+    const auto label_height =
+        static_cast<DefaultDim>(std::ceil(metrics.font_extents().height)) + 2;
+
+    if (b.width() <= label_width || b.height() <= label_height)
+        return {};
+
+    return {b.x() + label_width, b.y(),
+            b.width() - label_width, b.height() - label_height};
+}
+
+int64_t StreamChart::column_index(double x) const
+{
+    return static_cast<int64_t>(std::floor(x * m_columns_width / m_x_span));
+}
+
+bool StreamChart::add_column_sample(Series& series, double x, double y)
+{
+    auto& columns = series.columns;
+    const auto index = column_index(x);
+    bool scrolled = false;
+
+    if (columns.empty() || index > columns.back().index)
+    {
+        scrolled = true;
+
+        // columns stay consecutive, so a column is found by its index
+        auto start = columns.empty() ? index : columns.back().index + 1;
+        const auto oldest = index - static_cast<int64_t>(columns.capacity()) + 1;
+        if (start < oldest)
+        {
+            columns.clear();
+            start = oldest;
+        }
+
+        for (auto i = start; i <= index; ++i)
+        {
+            auto& column = columns.append();
+            column.index = i;
+            column.count = 0;
+        }
+    }
+    else if (index < columns.front().index)
+    {
+        // too old to be shown
+        return false;
+    }
+
+    auto& column = columns[index - columns.front().index];
+    const auto value = static_cast<float>(y);
+    if (!column.count)
+    {
+        column.first = column.min = column.max = value;
+    }
+    else
+    {
+        column.min = std::min(column.min, value);
+        column.max = std::max(column.max, value);
+    }
+    column.last = value;
+    ++column.count;
+
+    m_dirty_column = std::min(m_dirty_column, index);
+
+    if (!m_has_columns || index > m_last_column)
+    {
+        m_last_column = index;
+        m_has_columns = true;
+    }
+
+    return scrolled || (m_y_auto && (value < m_shown_min || value > m_shown_max));
+}
+
+void StreamChart::rebuild_columns(DefaultDim width)
+{
+    m_columns_width = width;
+    m_has_columns = false;
+
+    for (auto& s : m_series)
+    {
+        s.columns.capacity(width);
+        s.columns.clear();
+
+        for (size_t i = 0; i < s.size(); ++i)
+            add_column_sample(s, s.x_at(i), s.y_at(i));
+    }
+}
+
+bool StreamChart::update_y_range()
+{
+    if (!m_y_auto || !m_columns_width)
+        return false;
+
+    const auto first = m_last_column - m_columns_width + 1;
+    auto min = std::numeric_limits<float>::max();
+    auto max = std::numeric_limits<float>::lowest();
+    for (const auto& s : m_series)
+    {
+        for (size_t i = 0; i < s.columns.size(); ++i)
+        {
+            const auto& column = s.columns[i];
+            if (column.index < first || !column.count)
+                continue;
+            min = std::min(min, column.min);
+            max = std::max(max, column.max);
+        }
+    }
+
+    double low = 0.0;
+    double high = 1.0;
+    if (min <= max)
+    {
+        // keep the range while the samples fit and use at least half of it
+        if (min >= m_shown_min && max <= m_shown_max &&
+            (max - min) * 2. >= m_shown_max - m_shown_min)
+            return false;
+
+        const auto pad = min == max ? 1.0 : (max - min) * 0.1;
+        low = min - pad;
+        high = max + pad;
+    }
+
+    if (low == m_shown_min && high == m_shown_max)
+        return false;
+
+    m_shown_min = low;
+    m_shown_max = high;
+    return true;
+}
+
+void StreamChart::draw_axes(Painter& painter, const Rect& plot, double ymin, double ymax)
+{
+    auto cr = painter.context().get();
+
+    if (m_grid_divisions)
+    {
+        Painter::AutoSaveRestore sr(painter);
+        painter.set(color(Palette::ColorId::border));
+        painter.line_width(1);
+
+        for (size_t i = 0; i <= m_grid_divisions; ++i)
+        {
+            const auto x = std::floor(plot.x() + plot.width() * i /
+                                      static_cast<double>(m_grid_divisions));
+            const auto y = std::floor(plot.y() + plot.height() * i /
+                                      static_cast<double>(m_grid_divisions));
+            cairo_move_to(cr, std::min<double>(x, plot.right() - 1) + 0.5, plot.y());
+            cairo_line_to(cr, std::min<double>(x, plot.right() - 1) + 0.5, plot.bottom());
+            cairo_move_to(cr, plot.x(), std::min<double>(y, plot.bottom() - 1) + 0.5);
+            cairo_line_to(cr, plot.right(), std::min<double>(y, plot.bottom() - 1) + 0.5);
+        }
+
+        cairo_stroke(cr);
+    }
+
+    painter.set(font());
+    painter.set(color(Palette::ColorId::label_text));
+
+    const auto draw_label = [&painter](const std::string& text, const Point& point)
+    {
+        painter.draw(point);
+        painter.draw(text);
+    };
+
+    const auto top = format_label(ymax);
+    const auto bottom = format_label(ymin);
+    const auto height = painter.text_size(bottom).height();
+    draw_label(top, Point(plot.x() - painter.text_size(top).width() - 2, plot.y()));
+    draw_label(bottom, Point(plot.x() - painter.text_size(bottom).width() - 2,
+                             plot.bottom() - height));
+
+    // x is shown relative to the newest sample, so the labels do not change
+    // as the chart scrolls
+    const auto right = format_label(0);
+    const auto left = format_label(-m_x_span);
+    draw_label(left, Point(plot.x(), plot.bottom() + 2));
+    draw_label(right, Point(plot.right() - painter.text_size(right).width(),
+                            plot.bottom() + 2));
+}
+
+void StreamChart::draw_series(Painter& painter, const Rect& plot, const Series& series,
+                              double ymin, double ymax, int64_t from)
+{
+    auto cr = painter.context().get();
+    const auto first = m_last_column - m_columns_width + 1;
+    const auto start = std::max(first, from);
+    const auto scale = plot.height() / (ymax - ymin);
+    const auto to_y = [&](float value)
+    {
+        return plot.bottom() - (value - ymin) * scale;
+    };
+
+    bool started = false;
+    for (size_t i = 0; i < series.columns.size(); ++i)
+    {
+        const auto& column = series.columns[i];
+        if (column.index < start || !column.count)
+            continue;
+
+        const auto x = plot.x() + static_cast<double>(column.index - first) + 0.5;
+
+        // join to the last sample of the previous column
+        if (started)
+            cairo_line_to(cr, x, to_y(column.first));
+        else
+            cairo_move_to(cr, x, to_y(column.first));
+        started = true;
+
+        if (column.min != column.max)
+        {
+            cairo_move_to(cr, x, to_y(column.min));
+            cairo_line_to(cr, x, to_y(column.max));
+        }
+
+        cairo_move_to(cr, x, to_y(column.last));
+    }
+
+    painter.set(series.color);
+    cairo_stroke(cr);
+}
+
+void StreamChart::update_background(const Rect& plot, double ymin, double ymax)
+{
+    const auto size = box().size();
+    if (!m_background ||
+        cairo_image_surface_get_width(m_background.get()) != size.width() ||
+        cairo_image_surface_get_height(m_background.get()) != size.height())
+    {
+        m_background = shared_cairo_surface_t(
+                           cairo_image_surface_create(CAIRO_FORMAT_ARGB32, size.width(), size.height()),
+                           cairo_surface_destroy);
+        m_background_valid = false;
+    }
+
+    if (m_background_font != font())
+    {
+        m_background_font = font();
+        m_background_valid = false;
+    }
+
+    if (m_background_valid)
+        return;
+
+    Painter painter(shared_cairo_t(cairo_create(m_background.get()), cairo_destroy));
+    auto cr = painter.context().get();
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+
+    cairo_translate(cr, -box().x(), -box().y());
+    draw_box(painter, Palette::ColorId::bg, Palette::ColorId::border);
+    draw_axes(painter, plot, ymin, ymax);
+
+    cairo_surface_flush(m_background.get());
+    m_background_valid = true;
+}
+
+void StreamChart::update_plot(const Rect& plot, double ymin, double ymax)
+{
+    const auto width = plot.width();
+    const auto height = plot.height();
+    if (!m_plot ||
+        cairo_image_surface_get_width(m_plot.get()) != width ||
+        cairo_image_surface_get_height(m_plot.get()) != height)
+    {
+        m_plot = shared_cairo_surface_t(
+                     cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height),
+                     cairo_surface_destroy);
+        m_plot_valid = false;
+    }
+
+    const auto first = m_last_column - width + 1;
+    // a stroke reaches the pixels of the columns next to it
+    const auto reach = static_cast<int64_t>(std::ceil(m_line_width)) + 1;
+
+    auto from = first;
+    if (m_plot_valid && m_has_columns &&
+        m_last_column >= m_drawn_column && m_last_column - m_drawn_column < width)
+    {
+        // move what is already drawn left, and only draw the changed columns
+        const auto shift = static_cast<int>(m_last_column - m_drawn_column);
+        if (shift)
+        {
+            cairo_surface_flush(m_plot.get());
+            auto data = cairo_image_surface_get_data(m_plot.get());
+            const auto stride = cairo_image_surface_get_stride(m_plot.get());
+            for (auto y = 0; y < height; ++y)
+            {
+                auto row = data + y * stride;
+                memmove(row, row + shift * 4, (width - shift) * 4);
+            }
+            cairo_surface_mark_dirty(m_plot.get());
+        }
+
+        from = std::max(first, std::min(m_dirty_column, m_drawn_column + 1) - reach);
+    }
+
+    Painter painter(shared_cairo_t(cairo_create(m_plot.get()), cairo_destroy));
+    auto cr = painter.context().get();
+    cairo_rectangle(cr, from - first, 0, width - (from - first), height);
+    cairo_clip(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+
+    if (m_has_columns)
+    {
+        painter.line_width(m_line_width);
+        for (const auto& s : m_series)
+            draw_series(painter, Rect(0, 0, width, height), s, ymin, ymax, from - reach);
+    }
+
+    cairo_surface_flush(m_plot.get());
+    m_drawn_column = m_last_column;
+    m_dirty_column = std::numeric_limits<int64_t>::max();
+    m_plot_valid = true;
+}
+
+void StreamChart::draw(Painter& painter, const Rect&)
+{
+    const auto plot = plot_area();
+    m_plot_area = plot;
+    if (plot.empty())
+    {
+        draw_box(painter, Palette::ColorId::bg, Palette::ColorId::border);
+        return;
+    }
+
+    if (m_columns_width != plot.width())
+    {
+        rebuild_columns(plot.width());
+        update_y_range();
+        invalidate_layers();
+    }
+
+    const auto range = y_shown();
+
+    if (m_incremental)
+    {
+        if (range != m_plot_range)
+        {
+            m_plot_range = range;
+            invalidate_layers();
+        }
+
+        update_background(plot, range.first, range.second);
+        update_plot(plot, range.first, range.second);
+
+        Painter::AutoSaveRestore sr(painter);
+        auto cr = painter.context().get();
+        cairo_set_source_surface(cr, m_background.get(), x(), y());
+        cairo_rectangle(cr, x(), y(), width(), height());
+        cairo_fill(cr);
+        cairo_set_source_surface(cr, m_plot.get(), plot.x(), plot.y());
+        cairo_rectangle(cr, plot.x(), plot.y(), plot.width(), plot.height());
+        cairo_fill(cr);
+        return;
+    }
+
+    draw_box(painter, Palette::ColorId::bg, Palette::ColorId::border);
+
+    Painter::AutoSaveRestore sr(painter);
+    draw_axes(painter, plot, range.first, range.second);
+
+    if (!m_has_columns)
+        return;
+
+    auto cr = painter.context().get();
+    cairo_rectangle(cr, plot.x(), plot.y(), plot.width(), plot.height());
+    cairo_clip(cr);
+    cairo_new_path(cr);
+
+    painter.line_width(m_line_width);
+    for (const auto& s : m_series)
+        draw_series(painter, plot, s, range.first, range.second,
+                    std::numeric_limits<int64_t>::min());
+}
+
+}
+}
@@ -3,7 +3,13 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "detail/diskcache.h"
 #include "detail/dump.h"
+#include "detail/fmt.h"
 #include "egt/canvas.h"
 #include "egt/detail/filesystem.h"
 #include "egt/detail/meta.h"
@@ -181,6 +187,22 @@ shared_cairo_surface_t SvgImage::do_render(const std::string& id, const RectF& r
     if (!rect.empty())
         s = rect.size();
 
+    uint64_t key = 0;
+    if (detail::disk_cache().enabled())
+    {
+        const auto source = detail::DiskCache::source_hash(m_uri);
+        if (source)
+        {
+            key = detail::DiskCache::hash(source,
+                                          fmt::format("svg-{}-{}-{}-{}-{}-{}-{}",
+                                                  size().width(), size().height(), id,
+                                                  rect.x(), rect.y(), rect.width(), rect.height()));
+            auto surface = detail::disk_cache().load(key);
+            if (surface)
+                return surface;
+        }
+    }
+
     Canvas canvas(s);
     auto cr = canvas.context().get();
 
@@ -219,6 +241,9 @@ shared_cairo_surface_t SvgImage::do_render(const std::string& id, const RectF& r
 
     });
 
+    if (key)
+        detail::disk_cache().store(key, canvas.surface());
+
     return canvas.surface();
 }
 
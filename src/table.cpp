@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include "egt/detail/math.h"
+#include "egt/frame.h"
+#include "egt/painter.h"
+#include "egt/table.h"
+#include <algorithm>
+#include <cmath>
+
+namespace egt
+{
+inline namespace v1
+{
+
+constexpr DefaultDim TableView::DEFAULT_ROW_HEIGHT;
+constexpr DefaultDim TableView::DEFAULT_COLUMN_WIDTH;
+
+/// Space between the left edge of a cell and its text.
+static constexpr DefaultDim CELL_PADDING = 4;
+
+TableView::TableView(const Rect& rect, size_t rows, size_t columns) noexcept
+    : Widget(rect),
+      m_rows(rows),
+      m_columns(columns)
+{
+    name("TableView" + std::to_string(m_widgetid));
+
+    m_kinetic.overscroll(false);
+    m_kinetic.callback([this](const PointF & offset)
+    {
+        update_offset(Point(std::round(offset.x()), std::round(offset.y())));
+    });
+
+    fill_flags(Theme::FillFlag::blend);
+    border(theme().default_border());
+}
+
+TableView::TableView(Frame& parent, const Rect& rect, size_t rows, size_t columns) noexcept
+    : TableView(rect, rows, columns)
+{
+    parent.add(*this);
+}
+
+void TableView::resize(const Size& s)
+{
+    if (s != size())
+    {
+        Widget::resize(s);
+        update_offset(m_offset);
+    }
+}
+
+void TableView::row_count(size_t count)
+{
+    if (detail::change_if_diff<>(m_rows, count))
+    {
+        if (m_selected >= static_cast<ssize_t>(m_rows))
+            m_selected = -1;
+        update_offset(m_offset);
+        damage();
+    }
+}
+
+void TableView::column_count(size_t count)
+{
+    if (count != m_columns.size())
+    {
+        m_columns.resize(count);
+        m_column_x_valid = false;
+        update_offset(m_offset);
+        damage();
+    }
+}
+
+void TableView::column_width(size_t column, DefaultDim width)
+{
+    if (column >= m_columns.size())
+        return;
+
+    if (detail::change_if_diff<>(m_columns[column].width, std::max<DefaultDim>(width, 0)))
+    {
+        m_column_x_valid = false;
+        update_offset(m_offset);
+        damage();
+    }
+}
+
+DefaultDim TableView::column_width(size_t column) const
+{
+    if (column >= m_columns.size())
+        return 0;
+
+    return m_columns[column].width;
+}
+
+void TableView::column_title(size_t column, const std::string& title)
+{
+    if (column >= m_columns.size())
+        return;
+
+    if (detail::change_if_diff<>(m_columns[column].title, title))
+        damage();
+}
+
+const std::string& TableView::column_title(size_t column) const
+{
+    static const std::string empty;
+    if (column >= m_columns.size())
+        return empty;
+
+    return m_columns[column].title;
+}
+
+void TableView::row_height(DefaultDim height)
+{
+    if (height <= 0)
+        return;
+
+    if (detail::change_if_diff<>(m_row_height, height))
+    {
+        update_offset(m_offset);
+        damage();
+    }
+}
+
+void TableView::header(bool enabled)
+{
+    if (detail::change_if_diff<>(m_header, enabled))
+    {
+        update_offset(m_offset);
+        damage();
+    }
+}
+
+void TableView::cell_renderer(CellRenderer renderer)
+{
+    m_renderer = std::move(renderer);
+    damage();
+}
+
+void TableView::cell_text(CellText text)
+{
+    m_text = std::move(text);
+    damage();
+}
+
+void TableView::cell_changed(size_t row, size_t column)
+{
+    if (row >= m_rows || column >= m_columns.size())
+        return;
+
+    const auto cell = Rect::intersection(cell_rect(row, column) + point(), body_area());
+    if (!cell.empty())
+        damage(cell);
+}
+
+void TableView::selected(size_t row)
+{
+    if (row >= m_rows)
+        return;
+
+    const auto changed = m_selected != static_cast<ssize_t>(row);
+    m_selected = row;
+
+    if (changed)
+    {
+        damage();
+        on_selected_changed.invoke();
+    }
+
+    on_selected.invoke(row);
+}
+
+Rect TableView::body_area() const
+{
+    auto body = content_area();
+    const auto header = std::min(header_height(), body.height());
+    body.y(body.y() + header);
+    body.height(body.height() - header);
+    return body;
+}
+
+void TableView::update_column_x() const
+{
+    if (m_column_x_valid)
+        return;
+
+    m_column_x.resize(m_columns.size() + 1);
+    DefaultDim x = 0;
+    for (size_t c = 0; c < m_columns.size(); ++c)
+    {
+        m_column_x[c] = x;
+        x += m_columns[c].width;
+    }
+    m_column_x.back() = x;
+    m_column_x_valid = true;
+}
+
+std::pair<size_t, size_t> TableView::column_range(DefaultDim x0, DefaultDim x1) const
+{
+    update_column_x();
+
+    // the last column that starts at or before x0, up to the first that starts at x1
+    const auto begin = std::upper_bound(m_column_x.begin(), m_column_x.end() - 1, x0);
+    const auto end = std::lower_bound(begin, m_column_x.end() - 1, x1);
+    const auto first = begin == m_column_x.begin() ? 0 : begin - m_column_x.begin() - 1;
+    return {static_cast<size_t>(first), static_cast<size_t>(end - m_column_x.begin())};
+}
+
+Rect TableView::cell_rect(size_t row, size_t column) const
+{
+    if (column >= m_columns.size())
+        return {};
+
+    update_column_x();
+
+    const auto body = body_area() - point();
+    return {body.x() + m_column_x[column] - m_offset.x(),
+            body.y() + static_cast<DefaultDim>(row) * m_row_height - m_offset.y(),
+            m_columns[column].width,
+            m_row_height};
+}
+
+std::pair<ssize_t, ssize_t> TableView::cell_at(const Point& point) const
+{
+    const auto carea = content_area() - this->point();
+    if (!carea.intersect(point))
+        return {-1, -1};
+
+    const auto x = point.x() - carea.x() + m_offset.x();
+    const auto range = column_range(x, x + 1);
+    ssize_t column = -1;
+    if (range.first < range.second && x < m_column_x.back())
+        column = range.first;
+
+    const auto body = body_area() - this->point();
+    if (point.y() < body.y())
+        return {-1, column};
+
+    const auto row = (point.y() - body.y() + m_offset.y()) / m_row_height;
+    if (row < 0 || static_cast<size_t>(row) >= m_rows)
+        return {-1, column};
+
+    return {row, column};
+}
+
+Point TableView::offset_max() const
+{
+    update_column_x();
+
+    const auto body = body_area();
+    const auto width = static_cast<int64_t>(m_column_x.back());
+    const auto height = static_cast<int64_t>(m_rows) * m_row_height;
+    return {static_cast<DefaultDim>(std::max<int64_t>(0, width - body.width())),
+            static_cast<DefaultDim>(std::max<int64_t>(0, height - body.height()))};
+}
+
+void TableView::offset(const Point& offset)
+{
+    m_kinetic.stop();
+    update_offset(offset);
+}
+
+void TableView::update_offset(const Point& offset)
+{
+    const auto max = offset_max();
+    const Point clamped(detail::clamp<DefaultDim>(offset.x(), 0, max.x()),
+                        detail::clamp<DefaultDim>(offset.y(), 0, max.y()));
+    if (detail::change_if_diff<>(m_offset, clamped))
+        damage();
+}
+
+void TableView::scroll_to(size_t row)
+{
+    if (row >= m_rows)
+        return;
+
+    const auto top = static_cast<DefaultDim>(row) * m_row_height;
+    const auto height = body_area().height();
+    if (top < m_offset.y())
+        offset(Point(m_offset.x(), top));
+    else if (top + m_row_height > m_offset.y() + height)
+        offset(Point(m_offset.x(), top + m_row_height - height));
+}
+
+void TableView::draw_text(Painter& painter, const Rect& cell, const std::string& text)
+{
+    if (text.empty())
+        return;
+
+    const auto& fe = detail::FontMetrics::get(font().scaled_font()).font_extents();
+    auto cr = painter.context().get();
+    cairo_move_to(cr, cell.x() + CELL_PADDING,
+                  cell.y() + (cell.height() - fe.height) / 2. + fe.ascent);
+    cairo_show_text(cr, text.c_str());
+    cairo_new_path(cr);
+}
+
+void TableView::draw_cell(Painter& painter, const Rect& cell, size_t row, size_t column)
+{
+    Painter::AutoSaveRestore sr(painter);
+    auto cr = painter.context().get();
+    cairo_rectangle(cr, cell.x(), cell.y(), cell.width(), cell.height());
+    cairo_clip(cr);
+
+    if (m_renderer)
+        m_renderer(painter, cell, row, column);
+    else if (m_text)
+        draw_text(painter, cell, m_text(row, column));
+}
+
+void TableView::draw(Painter& painter, const Rect& rect)
+{
+    draw_box(painter, Palette::ColorId::bg, Palette::ColorId::border);
+
+    const auto carea = content_area();
+    const auto clip = Rect::intersection(rect, carea);
+    if (clip.empty() || m_columns.empty())
+        return;
+
+    update_column_x();
+
+    Painter::AutoSaveRestore sr(painter);
+    auto cr = painter.context().get();
+    cairo_rectangle(cr, clip.x(), clip.y(), clip.width(), clip.height());
+    cairo_clip(cr);
+    cairo_set_line_width(cr, 1);
+    painter.set(font());
+
+    // only the cells under the damaged rectangle
+    const auto body = body_area();
+    const auto area = Rect::intersection(clip, body);
+    if (!area.empty() && m_rows)
+    {
+        const auto top = area.y() - body.y() + m_offset.y();
+        const auto first_row = static_cast<size_t>(top / m_row_height);
+        const auto last_row = std::min(m_rows,
+                                       static_cast<size_t>((top + area.height() + m_row_height - 1) / m_row_height));
+        const auto left = area.x() - body.x() + m_offset.x();
+        const auto columns = column_range(left, left + area.width());
+        const auto right = std::min<DefaultDim>(body.x() + m_column_x.back() - m_offset.x(),
+                                                body.right());
+
+        for (auto row = first_row; row < last_row; ++row)
+        {
+            const auto y = body.y() + static_cast<DefaultDim>(row) * m_row_height - m_offset.y();
+
+            if (static_cast<ssize_t>(row) == m_selected)
+            {
+                painter.set(color(Palette::ColorId::text_highlight));
+                cairo_rectangle(cr, body.x(), y, right - body.x(), m_row_height);
+                cairo_fill(cr);
+            }
+
+            painter.set(color(Palette::ColorId::text));
+            for (auto column = columns.first; column < columns.second; ++column)
+            {
+                const Rect cell(body.x() + m_column_x[column] - m_offset.x(), y,
+                                m_columns[column].width, m_row_height);
+                draw_cell(painter, cell, row, column);
+            }
+
+            // line under the row
+            painter.set(color(Palette::ColorId::border));
+            cairo_move_to(cr, body.x(), y + m_row_height - 0.5);
+            cairo_line_to(cr, right, y + m_row_height - 0.5);
+            cairo_stroke(cr);
+        }
+
+        // lines right of the columns
+        const auto bottom = std::min<DefaultDim>(body.y() + static_cast<DefaultDim>(m_rows) * m_row_height - m_offset.y(),
+                                                 body.bottom());
+        painter.set(color(Palette::ColorId::border));
+        for (auto column = columns.first; column < columns.second; ++column)
+        {
+            const auto x = body.x() + m_column_x[column + 1] - m_offset.x() - 0.5;
+            cairo_move_to(cr, x, body.y());
+            cairo_line_to(cr, x, bottom);
+        }
+        cairo_stroke(cr);
+    }
+
+    // the header row does not scroll down with the rows
+    const auto header = Rect::intersection(clip, Rect(carea.x(), carea.y(), carea.width(),
+                                           std::min(header_height(), carea.height())));
+    if (!header.empty())
+    {
+        painter.set(color(Palette::ColorId::button_bg));
+        cairo_rectangle(cr, header.x(), header.y(), header.width(), header.height());
+        cairo_fill(cr);
+
+        const auto left = header.x() - carea.x() + m_offset.x();
+        const auto columns = column_range(left, left + header.width());
+        for (auto column = columns.first; column < columns.second; ++column)
+        {
+            const Rect cell(carea.x() + m_column_x[column] - m_offset.x(), carea.y(),
+                            m_columns[column].width, header_height());
+
+            painter.set(color(Palette::ColorId::button_text));
+            {
+                Painter::AutoSaveRestore sr2(painter);
+                cairo_rectangle(cr, cell.x(), cell.y(), cell.width(), cell.height());
+                cairo_clip(cr);
+                draw_text(painter, cell, m_columns[column].title);
+            }
+
+            painter.set(color(Palette::ColorId::border));
+            cairo_move_to(cr, cell.right() - 0.5, cell.y());
+            cairo_line_to(cr, cell.right() - 0.5, cell.bottom());
+            cairo_stroke(cr);
+        }
+    }
+}
+
+void TableView::handle(Event& event)
+{
+    switch (event.id())
+    {
+    case EventId::pointer_click:
+    {
+        const auto cell = cell_at(display_to_local(event.pointer().point));
+        if (cell.first >= 0)
+            selected(cell.first);
+
+        event.stop();
+        return;
+    }
+    case EventId::pointer_drag_start:
+        m_start_offset = m_offset;
+        m_kinetic.bounds(PointF(), PointF(offset_max().x(), offset_max().y()));
+        m_kinetic.begin(PointF(m_offset.x(), m_offset.y()));
+        event.stop();
+        return;
+    case EventId::pointer_drag:
+    {
+        const auto diff = event.pointer().point - event.pointer().drag_start;
+        const auto offset = m_kinetic.drag(PointF(m_start_offset.x() - diff.x(),
+                                                  m_start_offset.y() - diff.y()));
+        update_offset(Point(std::round(offset.x()), std::round(offset.y())));
+        event.stop();
+        return;
+    }
+    case EventId::pointer_drag_stop:
+        m_kinetic.release();
+        event.stop();
+        return;
+    case EventId::raw_pointer_down:
+        // touching stops a fling
+        m_kinetic.stop();
+        return;
+    default:
+        break;
+    }
+
+    Widget::handle(event);
+}
+
+}
+}
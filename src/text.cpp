@@ -7,8 +7,9 @@
 #include "config.h"
 #endif
 
+#include "detail/fontmetrics.h"
+#include "detail/glyphatlas.h"
 #include "detail/utf8text.h"
-#include "egt/canvas.h"
 #include "egt/detail/alignment.h"
 #include "egt/detail/enum.h"
 #include "egt/detail/layout.h"
@@ -70,6 +71,8 @@ m_text_flags(flags)
 
     m_timer.on_timeout([this]() { cursor_timeout(); });
 
+    text_flags_changed();
+
     insert(text);
 
     m_gain_focus_reg = on_gain_focus([this]()
@@ -153,7 +156,7 @@ void TextBox::handle_key(const Key& key)
     }
     case EKEY_ENTER:
     {
-        if (text_flags().is_set(TextFlag::multiline))
+        if (text_flags().is_set(TextFlag::multiline) || m_document)
             insert("\n");
         break;
     }
@@ -170,7 +173,17 @@ void TextBox::handle_key(const Key& key)
     /// NOLINTNEXTLINE(bugprone-branch-clone)
     case EKEY_UP:
     {
-        if (text_flags().is_set(TextFlag::multiline))
+        if (m_document)
+        {
+            const auto line = m_document->line_at(cursor());
+            if (line)
+            {
+                const auto column = cursor() - m_document->line_start(line);
+                cursor_set(m_document->line_start(line - 1) +
+                           std::min(column, m_document->line_length(line - 1)));
+            }
+        }
+        else if (text_flags().is_set(TextFlag::multiline))
         {
             // TODO
         }
@@ -178,7 +191,17 @@ void TextBox::handle_key(const Key& key)
     }
     case EKEY_DOWN:
     {
-        if (text_flags().is_set(TextFlag::multiline))
+        if (m_document)
+        {
+            const auto line = m_document->line_at(cursor());
+            if (line + 1 < m_document->line_count())
+            {
+                const auto column = cursor() - m_document->line_start(line);
+                cursor_set(m_document->line_start(line + 1) +
+                           std::min(column, m_document->line_length(line + 1)));
+            }
+        }
+        else if (text_flags().is_set(TextFlag::multiline))
         {
             // TODO
         }
@@ -187,12 +210,17 @@ void TextBox::handle_key(const Key& key)
     /// NOLINTNEXTLINE(bugprone-branch-clone)
     case EKEY_END:
     {
-        // TODO
+        if (m_document)
+        {
+            const auto line = m_document->line_at(cursor());
+            cursor_set(m_document->line_start(line) + m_document->line_length(line));
+        }
         break;
     }
     case EKEY_HOME:
     {
-        // TODO
+        if (m_document)
+            cursor_set(m_document->line_start(m_document->line_at(cursor())));
         break;
     }
     default:
@@ -229,7 +257,14 @@ void TextBox::draw(Painter& painter, const Rect&)
         }
     };
 
-    detail::draw_text(painter,
+    if (m_document)
+    {
+        draw_document(painter, draw_cursor);
+        return;
+    }
+
+    detail::draw_text(text_layout(),
+                      painter,
                       content_area(),
                       m_text,
                       font(),
@@ -244,6 +279,126 @@ void TextBox::draw(Painter& painter, const Rect&)
                       m_select_len);
 }
 
+void TextBox::draw_document(Painter& painter,
+                            const std::function<void(const Point& offset, size_t height)>& draw_cursor)
+{
+    auto& document = *m_document;
+    const auto b = content_area();
+    const auto& fe = detail::FontMetrics::get(font().scaled_font()).font_extents();
+    if (b.empty() || fe.height <= 0)
+        return;
+
+    const auto height = static_cast<float>(fe.height);
+    const auto ascent = static_cast<float>(fe.ascent);
+
+    // scroll to keep the cursor visible
+    const auto cursor_line = document.line_at(m_cursor_pos);
+    const auto rows = std::max<size_t>(1, static_cast<size_t>(b.height() / height));
+    if (cursor_line < m_first_line)
+        m_first_line = cursor_line;
+    else if (cursor_line >= m_first_line + rows)
+        m_first_line = cursor_line - rows + 1;
+    m_first_line = std::min(m_first_line, document.line_count() - 1);
+
+    const auto& cursor_layout = document.layout(cursor_line, font());
+    const auto cursor_x = cursor_layout.x[m_cursor_pos - document.line_start(cursor_line)];
+    if (cursor_x < m_scroll_x)
+        m_scroll_x = cursor_x;
+    else if (cursor_x > m_scroll_x + b.width() - 2)
+        m_scroll_x = cursor_x - b.width() + 2;
+
+    // include a partially visible last line
+    const auto last = std::min(document.line_count(), m_first_line + rows + 1);
+    document.keep_layouts(m_first_line, last);
+
+    const auto x = b.x() - m_scroll_x;
+    const auto line_y = [&](size_t line)
+    {
+        return b.y() + (line - m_first_line) * height;
+    };
+
+    {
+        Painter::AutoSaveRestore sr(painter);
+        painter.draw(b);
+        painter.clip();
+
+        if (m_select_len)
+        {
+            const auto select_end = m_select_start + m_select_len;
+            painter.set(color(Palette::ColorId::text_highlight));
+            for (auto line = m_first_line; line < last; ++line)
+            {
+                const auto start = document.line_start(line);
+                const auto length = document.line_length(line);
+                if (select_end <= start || m_select_start > start + length)
+                    continue;
+
+                const auto& layout = document.layout(line, font());
+                const auto from = std::max(m_select_start, start) - start;
+                const auto to = std::min(select_end, start + length) - start;
+                auto width = layout.x[to] - layout.x[from];
+                // show a selected line break as a space
+                if (select_end > start + length && line + 1 < document.line_count())
+                    width += height / 4;
+
+                if (width > 0)
+                    painter.draw(RectF(x + layout.x[from], line_y(line), width, height));
+            }
+            painter.fill();
+        }
+
+        auto cr = painter.context().get();
+        painter.set(font());
+        painter.set(color(Palette::ColorId::text));
+        for (auto line = m_first_line; line < last; ++line)
+        {
+            const auto& layout = document.layout(line, font());
+            if (layout.run.empty())
+                continue;
+
+            const auto baseline = line_y(line) + ascent;
+            if (layout.indexed)
+            {
+                Painter::AutoSaveRestore sr2(painter);
+                cairo_translate(cr, x, baseline);
+                if (!detail::GlyphAtlas::show_glyphs(cr, layout.run.data(), layout.run.size()))
+                    cairo_show_glyphs(cr, layout.run.data(), layout.run.size());
+            }
+            else
+            {
+                cairo_move_to(cr, x, baseline);
+                cairo_show_text(cr, document.line(line).c_str());
+            }
+        }
+        cairo_new_path(cr);
+    }
+
+    draw_cursor(Point(x + cursor_x, line_y(cursor_line)), height);
+}
+
+void TextBox::text_flags_changed()
+{
+    if (text_flags().is_set(TextFlag::large_document))
+    {
+        if (!m_document)
+        {
+            m_document = std::make_unique<detail::TextDocument>(m_text);
+            m_text.clear();
+            m_text.shrink_to_fit();
+            m_first_line = 0;
+            m_scroll_x = 0;
+            text_layout().clear();
+        }
+    }
+    else if (m_document)
+    {
+        m_text = m_document->str();
+        m_document.reset();
+    }
+
+    damage();
+}
+
 void TextBox::text(const std::string& str)
 {
     selection_clear();
@@ -251,18 +406,55 @@ void TextBox::text(const std::string& str)
     insert(str);
 }
 
+const std::string& TextBox::text() const
+{
+    if (m_document)
+        return m_document->str();
+    return m_text;
+}
+
+size_t TextBox::len() const
+{
+    if (m_document)
+        return m_document->length();
+    return TextWidget::len();
+}
+
 void TextBox::clear()
 {
     selection_clear();
     cursor_begin();
-    TextWidget::clear();
+    if (m_document)
+    {
+        if (!m_document->empty())
+        {
+            m_document->clear();
+            m_first_line = 0;
+            m_scroll_x = 0;
+            on_text_changed.invoke();
+            damage();
+        }
+    }
+    else
+    {
+        TextWidget::clear();
+    }
 }
 
 void TextBox::max_length(size_t len)
 {
     if (detail::change_if_diff<>(m_max_len, len))
     {
-        if (m_max_len)
+        if (m_max_len && m_document)
+        {
+            if (m_document->length() > m_max_len)
+            {
+                m_document->erase(m_max_len, m_document->length() - m_max_len);
+                cursor_set(cursor());
+                on_text_changed.invoke();
+            }
+        }
+        else if (m_max_len)
         {
             const auto length = detail::utf8len(m_text);
             if (length > m_max_len)
@@ -288,22 +480,17 @@ size_t TextBox::width_to_len(const std::string& str) const
 {
     const auto b = content_area();
 
-    Canvas c(Size(1, 1));
-    auto cr = c.context();
-    Painter painter(cr);
-    painter.set(font());
+    auto& metrics = detail::FontMetrics::get(font().scaled_font());
 
     size_t len = 0;
     float total = 0;
     for (detail::utf8_const_iterator ch(str.begin(), str.begin(), str.end());
          ch != detail::utf8_const_iterator(str.end(), str.begin(), str.end()); ++ch)
     {
-        const auto txt = detail::utf8_char_to_string(ch.base(), str.cend());
-        cairo_text_extents_t te;
-        cairo_text_extents(cr.get(), txt.c_str(), &te);
-        if (total + static_cast<float>(te.x_advance) > b.width())
+        const auto advance = metrics.glyph(*ch).x_advance;
+        if (total + advance > b.width())
             return len;
-        total += static_cast<float>(te.x_advance);
+        total += advance;
         len++;
     }
 
@@ -315,7 +502,7 @@ size_t TextBox::insert(const std::string& str)
     if (str.empty())
         return 0;
 
-    const auto current_len = detail::utf8len(m_text);
+    const auto current_len = this->len();
     auto len = detail::utf8len(str);
 
     if (m_max_len)
@@ -326,6 +513,7 @@ size_t TextBox::insert(const std::string& str)
 
     if (!text_flags().is_set(TextFlag::multiline) &&
         text_flags().is_set(TextFlag::fit_to_width) &&
+        !m_document &&
         !content_area().empty())
     {
         /*
@@ -353,11 +541,18 @@ size_t TextBox::insert(const std::string& str)
     if (len > 0)
     {
         // insert at cursor position
-        auto i = m_text.begin();
-        utf8::advance(i, m_cursor_pos, m_text.end());
         auto end = str.begin();
         utf8::advance(end, len, str.end());
-        m_text.insert(i, str.begin(), end);
+        if (m_document)
+        {
+            m_document->insert(m_cursor_pos, std::string(str.begin(), end));
+        }
+        else
+        {
+            auto i = m_text.begin();
+            utf8::advance(i, m_cursor_pos, m_text.end());
+            m_text.insert(i, str.begin(), end);
+        }
         cursor_forward(len);
         selection_clear();
         continue_show_cursor();
@@ -382,7 +577,7 @@ void TextBox::cursor_begin()
 void TextBox::cursor_end()
 {
     // one past end
-    cursor_set(detail::utf8len(m_text));
+    cursor_set(len());
 }
 
 void TextBox::cursor_forward(size_t count)
@@ -400,7 +595,7 @@ void TextBox::cursor_backward(size_t count)
 
 void TextBox::cursor_set(size_t pos)
 {
-    const auto len = detail::utf8len(m_text);
+    const auto len = this->len();
     if (pos > len)
         pos = len;
 
@@ -415,20 +610,17 @@ void TextBox::cursor_set(size_t pos)
 
 void TextBox::selection_all()
 {
-    selection(0, detail::utf8len(m_text));
+    selection(0, len());
 }
 
 void TextBox::selection(size_t pos, size_t length)
 {
-    const auto len = detail::utf8len(m_text);
+    const auto len = this->len();
     if (pos > len)
         pos = len;
 
-    auto i = m_text.begin();
-    utf8::advance(i, pos, m_text.end());
-    size_t d = utf8::distance(i, m_text.end());
-    if (length > d)
-        length = d;
+    if (length > len - pos)
+        length = len - pos;
 
     if (pos != m_select_start || length != m_select_len)
     {
@@ -449,6 +641,9 @@ void TextBox::selection_clear()
 
 std::string TextBox::selected_text() const
 {
+    if (m_select_len && m_document)
+        return m_document->substr(m_select_start, m_select_len);
+
     if (m_select_len)
     {
         auto i = m_text.begin();
@@ -464,7 +659,15 @@ std::string TextBox::selected_text() const
 
 void TextBox::selection_delete()
 {
-    if (m_select_len)
+    if (m_select_len && m_document)
+    {
+        m_document->erase(m_select_start, m_select_len);
+        cursor_set(m_select_start);
+        selection_clear();
+        on_text_changed.invoke();
+        damage();
+    }
+    else if (m_select_len)
     {
         auto i = m_text.begin();
         utf8::advance(i, m_select_start, m_text.end());
@@ -536,7 +739,8 @@ Size TextBox::min_size_hint() const
     if (!m_min_size.empty())
         return m_min_size;
 
-    auto text = m_text;
+    // the first line is enough to size a document
+    auto text = m_document ? m_document->line(0) : m_text;
     if (text.empty())
         text = "Hello World";
 
@@ -558,6 +762,7 @@ const std::pair<TextBox::TextFlag, char const*> detail::EnumStrings<TextBox::Tex
     {TextBox::TextFlag::multiline, "multiline"},
     {TextBox::TextFlag::word_wrap, "word_wrap"},
     {TextBox::TextFlag::no_virt_keyboard, "no_virt_keyboard"},
+    {TextBox::TextFlag::large_document, "large_document"},
 };
 
 void TextBox::serialize(Serializer& serializer) const
@@ -582,7 +787,10 @@ void TextBox::deserialize(const std::string& name, const std::string& value,
     if (name == "maxlength")
         max_length(std::stoul(value));
     else if (name == "text_flags")
+    {
         m_text_flags.from_string(value);
+        text_flags_changed();
+    }
     else if (name == "cursor")
         cursor_set(std::stoul(value));
     else if (name == "selection_start")
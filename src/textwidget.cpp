@@ -3,12 +3,11 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include "detail/fontmetrics.h"
 #include "detail/utf8text.h"
-#include "egt/canvas.h"
-#include "egt/painter.h"
 #include "egt/serialize.h"
 #include "egt/textwidget.h"
-#include <deque>
+#include <cmath>
 
 namespace egt
 {
@@ -51,84 +50,49 @@ size_t TextWidget::len() const
 
 Font TextWidget::scale_font(const Size& target, const std::string& text, const Font& font)
 {
-    Canvas canvas(Size(10, 10));
-    Painter painter(canvas.context());
-
-    auto nfont = font;
-    while (true)
+    const auto fits = [&target, &text](const Font & f)
     {
-        painter.set(nfont);
-
-        cairo_text_extents_t textext;
-        cairo_text_extents(painter.context().get(), text.c_str(), &textext);
-
-        if (textext.width - textext.x_bearing < target.width() &&
-            textext.height - textext.y_bearing < target.height())
-            return nfont;
-
-        nfont.size(nfont.size() - 1);
-        if (nfont.size() < 1)
-            return font;
-    }
-    return nfont;
-}
-
-struct SizeCache
-{
-    struct SizeItem
-    {
-        std::string text;
-        Font font;
+        const auto textext = detail::FontMetrics::get(f.scaled_font()).text_extents(text);
+        return textext.width - textext.x_bearing < target.width() &&
+               textext.height - textext.y_bearing < target.height();
     };
 
-    std::deque<std::pair<SizeItem, Size>>::iterator find(const std::string& text, const Font& font)
+    if (fits(font))
+        return font;
+
+    // binary search for the largest size, in whole steps down, that fits
+    auto nfont = font;
+    int lo = 1;
+    int hi = static_cast<int>(std::floor(font.size() - 1));
+    int found = 0;
+    while (lo <= hi)
     {
-        for (auto i = cache.begin(); i != cache.end(); ++i)
+        const auto mid = lo + (hi - lo) / 2;
+        nfont.size(font.size() - mid);
+        if (fits(nfont))
         {
-            if (i->first.text == text && i->first.font == font)
-                return i;
+            found = mid;
+            hi = mid - 1;
         }
-
-        return cache.end();
-    }
-
-    std::deque<std::pair<SizeItem, Size>>::iterator end()
-    {
-        return cache.end();
-    }
-
-    void add(const std::pair<SizeItem, Size>& item)
-    {
-        static constexpr auto MAX_CACHE_ITEM_SIZE = 1024;
-        if (item.first.text.size() < MAX_CACHE_ITEM_SIZE)
+        else
         {
-            cache.emplace_back(item);
-
-            static constexpr auto MAX_CACHE_ITEMS = 128;
-            while (cache.size() > MAX_CACHE_ITEMS)
-                cache.pop_front();
+            lo = mid + 1;
         }
     }
 
-private:
-    std::deque<std::pair<SizeItem, Size>> cache;
-};
+    if (!found)
+        return font;
 
-static SizeCache size_cache;
+    nfont.size(font.size() - found);
+    return nfont;
+}
 
 Size TextWidget::text_size(const std::string& text) const
 {
-    auto i = size_cache.find(text, this->font());
-    if (i != size_cache.end())
-        return i->second;
-
-    Canvas canvas(Size(100, 100));
-    Painter painter(canvas.context());
-    painter.set(this->font());
-
-    auto size = painter.font_size(text);
-    size_cache.add(std::make_pair(SizeCache::SizeItem{text, this->font()}, size));
-    return size;
+    auto& metrics = detail::FontMetrics::get(this->font().scaled_font());
+    const auto textext = metrics.text_extents(text);
+    return {static_cast<Size::DimType>(std::floor(textext.width + 1.0)),
+            static_cast<Size::DimType>(std::floor(metrics.font_extents().height + 1.0))};
 }
 
 void TextWidget::serialize(Serializer& serializer) const
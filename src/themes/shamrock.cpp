@@ -25,7 +25,8 @@ void ShamrockTheme::init_draw()
 
         widget.draw_circle(painter, Palette::ColorId::button_bg, Palette::ColorId::border);
 
-        detail::draw_text(painter,
+        detail::draw_text(widget.text_layout(),
+                          painter,
                           widget.content_area(),
                           widget.text(),
                           widget.font(),
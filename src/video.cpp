@@ -209,9 +209,9 @@ void VideoWindow::resize(const Size& size)
 {
     /*
      * sama5d4 does not support changing video resolution dynamically
-     * due to g1kmssink in client mode.
+     * due to g1kmssink in client mode, which is only used with a plane.
      */
-    if ((box().size() != size) && (!detail::is_target_sama5d4()))
+    if ((box().size() != size) && !(plane_window() && detail::is_target_sama5d4()))
     {
         pause();
         Window::resize(size);
@@ -225,6 +225,21 @@ bool VideoWindow::has_audio() const
     return m_video_impl->has_audio();
 }
 
+uint64_t VideoWindow::frames_decoded() const
+{
+    return m_video_impl->frames_decoded();
+}
+
+uint64_t VideoWindow::frames_dropped() const
+{
+    return m_video_impl->frames_dropped();
+}
+
+uint64_t VideoWindow::frames_displayed() const
+{
+    return m_video_impl->frames_displayed();
+}
+
 void VideoWindow::serialize(Serializer& serializer) const
 {
     Window::serialize(serializer);
@@ -8,6 +8,8 @@
 #include "egt/input.h"
 #include "egt/painter.h"
 #include "egt/view.h"
+#include <algorithm>
+#include <cmath>
 
 namespace egt
 {
@@ -37,6 +39,11 @@ ScrolledView::ScrolledView(const Rect& rect,
                                   Slider::SliderFlag::consistent_line});
 
     resize_slider();
+
+    m_kinetic.callback([this](const PointF & offset)
+    {
+        update_offset(Point(std::round(offset.x()), std::round(offset.y())), true);
+    });
 }
 
 ScrolledView::ScrolledView(Frame& parent, const Rect& rect,
@@ -55,18 +62,146 @@ ScrolledView::ScrolledView(Frame& parent,
     parent.add(*this);
 }
 
+constexpr DefaultDim ScrolledView::TILE_SIZE;
+
 void ScrolledView::draw(Painter& painter, const Rect& rect)
 {
-    if (!m_canvas)
+    const auto content = to_child(super_rect());
+    if (content.empty())
         return;
 
     //
-    // All children are drawn to the internal m_canvas.  Then, the proper part
-    // of the canvas is drawn based on of the m_offset.
+    // All children are drawn to tiles of the content.  Then, the proper part
+    // of each tile under the view is drawn based on of the m_offset.
     //
-    Painter cpainter(m_canvas->context());
 
-    Rect crect = to_child(super_rect());
+    // change origin to paint tiles and sliders
+
+    Painter::AutoSaveRestore sr(painter);
+
+    Point origin = point();
+    if (origin.x() || origin.y())
+    {
+        //
+        // Origin about to change
+        //
+        auto cr = painter.context();
+        cairo_translate(cr.get(),
+                        origin.x(),
+                        origin.y());
+    }
+
+    // limit to content area and to what is damaged
+    auto mrect = Rect::intersection(to_child(box()), to_child(content_area()));
+    mrect = Rect::intersection(mrect, to_child(rect));
+
+    // enough tiles to cover the view, with a margin of a row and a column
+    const auto view = content_area().size();
+    const auto cols = static_cast<size_t>((view.width() + TILE_SIZE - 1) / TILE_SIZE + 1);
+    const auto rows = static_cast<size_t>((view.height() + TILE_SIZE - 1) / TILE_SIZE + 1);
+    m_max_tiles = cols * rows + cols + rows;
+    if (m_tiles.size() > m_max_tiles)
+    {
+        std::sort(m_tiles.begin(), m_tiles.end(), [](const Tile & lhs, const Tile & rhs)
+        {
+            return lhs.used > rhs.used;
+        });
+        m_tiles.resize(m_max_tiles);
+    }
+
+    // part of the content under the view
+    auto visible = mrect;
+    visible -= m_offset;
+    visible = Rect::intersection(visible, content);
+
+    if (!visible.empty())
+    {
+        auto cr = painter.context().get();
+
+        const auto floor_div = [](DefaultDim v)
+        {
+            return v >= 0 ? v / TILE_SIZE : (v - TILE_SIZE + 1) / TILE_SIZE;
+        };
+
+        for (auto ty = floor_div(visible.top()); ty <= floor_div(visible.bottom() - 1); ++ty)
+        {
+            for (auto tx = floor_div(visible.left()); tx <= floor_div(visible.right() - 1); ++tx)
+            {
+                const auto& t = tile(Point(tx, ty), content);
+
+                const Rect trect(tx * TILE_SIZE, ty * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+                auto target = Rect::intersection(trect, visible);
+                target += m_offset;
+
+                cairo_set_source_surface(cr, t.surface.get(),
+                                         trect.x() + m_offset.x(),
+                                         trect.y() + m_offset.y());
+                cairo_rectangle(cr, target.x(), target.y(), target.width(), target.height());
+                painter.fill();
+            }
+        }
+    }
+
+    if (hscrollable())
+        m_hslider.draw(painter, rect);
+    if (vscrollable())
+        m_vslider.draw(painter, rect);
+}
+
+ScrolledView::Tile& ScrolledView::tile(const Point& index, const Rect& content)
+{
+    ++m_tile_clock;
+
+    for (auto& t : m_tiles)
+    {
+        if (t.index == index)
+        {
+            t.used = m_tile_clock;
+            if (t.dirty)
+                render_tile(t, content);
+            return t;
+        }
+    }
+
+    Tile* t;
+    if (m_tiles.size() < m_max_tiles)
+    {
+        m_tiles.emplace_back();
+        t = &m_tiles.back();
+        t->surface = shared_cairo_surface_t(
+                         cairo_image_surface_create(CAIRO_FORMAT_ARGB32, TILE_SIZE, TILE_SIZE),
+                         cairo_surface_destroy);
+    }
+    else
+    {
+        // reuse the least recently used tile
+        t = &*std::min_element(m_tiles.begin(), m_tiles.end(), [](const Tile & lhs, const Tile & rhs)
+        {
+            return lhs.used < rhs.used;
+        });
+    }
+
+    t->index = index;
+    t->used = m_tile_clock;
+    render_tile(*t, content);
+    return *t;
+}
+
+void ScrolledView::render_tile(Tile& tile, const Rect& content)
+{
+    Painter cpainter(shared_cairo_t(cairo_create(tile.surface.get()), cairo_destroy));
+    auto cr = cpainter.context().get();
+
+    const Rect trect(tile.index.x() * TILE_SIZE, tile.index.y() * TILE_SIZE,
+                     TILE_SIZE, TILE_SIZE);
+
+    cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(cr);
+    cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+
+    cairo_translate(cr, -trect.x(), -trect.y());
+    cpainter.draw(trect);
+    cpainter.clip();
 
     if (!fill_flags().empty())
     {
@@ -78,7 +213,7 @@ void ScrolledView::draw(Painter& painter, const Rect& rect)
 
         theme().draw_box(cpainter,
                          fill_flags(),
-                         crect /*m_canvas->size()*//*to_child(box())*/,
+                         content,
                          color(Palette::ColorId::border, group),
                          color(Palette::ColorId::bg, group),
                          border(),
@@ -95,62 +230,61 @@ void ScrolledView::draw(Painter& painter, const Rect& rect)
         if (child->plane_window())
             continue;
 
-        if (child->box().intersect(crect))
-        {
-            // don't give a child a rectangle that is outside of its own box
-            const auto r = Rect::intersection(crect, child->box());
-            if (r.empty())
-                continue;
+        // don't give a child a rectangle that is outside of its own box
+        const auto r = Rect::intersection(trect, child->box());
+        if (r.empty())
+            continue;
 
+        {
+            // no matter what the child draws, clip the output to only the
+            // rectangle we care about updating
+            Painter::AutoSaveRestore sr2(cpainter);
+            if (clip())
             {
-                // no matter what the child draws, clip the output to only the
-                // rectangle we care about updating
-                Painter::AutoSaveRestore sr2(cpainter);
-                if (clip())
-                {
-                    cpainter.draw(r);
-                    cpainter.clip();
-                }
-
-                detail::code_timer(false, child->name() + " draw: ", [&]()
-                {
-                    child->draw(cpainter, r);
-                });
+                cpainter.draw(r);
+                cpainter.clip();
             }
 
-            special_child_draw(cpainter, child.get());
+            detail::code_timer(false, child->name() + " draw: ", [&]()
+            {
+                child->draw(cpainter, r);
+            });
         }
-    }
 
-    // change origin to paint canvas area and sliders
+        special_child_draw(cpainter, child.get());
+    }
 
-    Painter::AutoSaveRestore sr(painter);
+    cairo_surface_flush(tile.surface.get());
+    tile.dirty = false;
+}
 
-    Point origin = point();
-    if (origin.x() || origin.y())
+void ScrolledView::invalidate_tiles(const Rect& rect)
+{
+    for (auto& t : m_tiles)
     {
-        //
-        // Origin about to change
-        //
-        auto cr = painter.context();
-        cairo_translate(cr.get(),
-                        origin.x(),
-                        origin.y());
+        const Rect trect(t.index.x() * TILE_SIZE, t.index.y() * TILE_SIZE,
+                         TILE_SIZE, TILE_SIZE);
+        if (trect.intersect(rect))
+            t.dirty = true;
     }
+}
 
-    // limit to content area
-    const auto mrect = Rect::intersection(to_child(box()), to_child(content_area()));
+void ScrolledView::damage(const Rect& /*rect*/)
+{
+    for (auto& t : m_tiles)
+        t.dirty = true;
 
-    cairo_set_source_surface(painter.context().get(), m_canvas->surface().get(),
-                             m_offset.x(), m_offset.y());
-    cairo_rectangle(painter.context().get(),
-                    mrect.point().x(), mrect.point().y(), mrect.width(), mrect.height());
-    painter.fill();
+    Frame::damage(box());
+}
 
-    if (hscrollable())
-        m_hslider.draw(painter, rect);
-    if (vscrollable())
-        m_vslider.draw(painter, rect);
+void ScrolledView::damage_from_child(const Rect& rect)
+{
+    invalidate_tiles(to_child(rect));
+
+    // only the part that is in view needs to be drawn again
+    auto visible = rect;
+    visible += m_offset;
+    Frame::damage(Rect::intersection(visible, content_area()));
 }
 
 void ScrolledView::resize(const Size& size)
@@ -184,16 +318,16 @@ void ScrolledView::layout()
     if (hold != hscrollable() || vold != vscrollable())
     {
         resize_slider();
-        damage();
+        Frame::damage(box());
     }
 
     update_sliders();
 
     auto s = super_rect().size();
 
-    if (!m_canvas || m_canvas->size() != s)
+    if (m_content_size != s)
     {
-        m_canvas = std::make_unique<Canvas>(s);
+        m_content_size = s;
         damage();
     }
 }
@@ -245,24 +379,49 @@ Point ScrolledView::offset_max() const
 }
 
 void ScrolledView::offset(Point offset)
+{
+    m_kinetic.stop();
+    update_offset(offset, false);
+}
+
+void ScrolledView::update_offset(Point offset, bool overscroll)
 {
     if (hscrollable() || vscrollable())
     {
-        auto offmax = offset_max();
-        if (offset.x() > 0)
+        if (!hscrollable())
             offset.x(0);
-        else if (offset.x() < offmax.x())
-            offset.x(offmax.x());
-
-        if (offset.y() > 0)
+        if (!vscrollable())
             offset.y(0);
-        else if (offset.y() < offmax.y())
-            offset.y(offmax.y());
 
+        if (!overscroll)
+        {
+            auto offmax = offset_max();
+            if (offset.x() > 0)
+                offset.x(0);
+            else if (offset.x() < offmax.x())
+                offset.x(offmax.x());
+
+            if (offset.y() > 0)
+                offset.y(0);
+            else if (offset.y() < offmax.y())
+                offset.y(offmax.y());
+        }
+
+        const auto delta = offset - m_offset;
         if (detail::change_if_diff<>(m_offset, offset))
         {
             update_sliders();
-            damage();
+
+            // the content did not change, only the part of it in view, so
+            // move what is on the screen and only draw what is uncovered
+            auto area = content_area();
+            if (hscrollable())
+                area.height(std::min(area.bottom(), box().bottom() - m_slider_dim) - area.y());
+            if (vscrollable())
+                area.width(std::min(area.right(), box().right() - m_slider_dim) - area.x());
+
+            if (!scroll_damage(area, delta))
+                Frame::damage(box());
         }
     }
 }
@@ -270,21 +429,24 @@ void ScrolledView::offset(Point offset)
 void ScrolledView::update_sliders()
 {
     const auto offmax = offset_max();
+    // the offset may be past the end while bouncing back
+    const auto offset = Point(detail::clamp(m_offset.x(), offmax.x(), 0),
+                              detail::clamp(m_offset.y(), offmax.y(), 0));
 
     if (offmax.x() < 0)
     {
         const auto hslider_value =
-            egt::detail::normalize<float>(std::abs(m_offset.x()), 0, -offmax.x(), 0, 100);
+            egt::detail::normalize<float>(std::abs(offset.x()), 0, -offmax.x(), 0, 100);
         if (!detail::float_equal(m_hslider.value(hslider_value), hslider_value))
-            damage();
+            Frame::damage(m_hslider.box() + point());
     }
 
     if (offmax.y() < 0)
     {
         const auto vslider_value =
-            egt::detail::normalize<float>(std::abs(m_offset.y()), 0, -offmax.y(), 0, 100);
+            egt::detail::normalize<float>(std::abs(offset.y()), 0, -offmax.y(), 0, 100);
         if (!detail::float_equal(m_vslider.value(vslider_value), vslider_value))
-            damage();
+            Frame::damage(m_vslider.box() + point());
     }
 }
 
@@ -294,16 +456,27 @@ void ScrolledView::handle(Event& event)
 
     switch (event.id())
     {
+    case EventId::raw_pointer_down:
+        // touching stops a fling
+        m_kinetic.stop();
+        break;
     case EventId::pointer_drag_start:
         m_start_offset = m_offset;
+        m_kinetic.bounds(PointF(offset_max()), PointF());
+        m_kinetic.begin(PointF(m_offset));
         break;
     case EventId::pointer_drag:
     {
         auto diff = event.pointer().point -
                     event.pointer().drag_start;
-        offset(m_start_offset + Point(diff.x(), diff.y()));
+        const auto offset = m_kinetic.drag(PointF(m_start_offset + Point(diff.x(), diff.y())));
+        update_offset(Point(std::round(offset.x()), std::round(offset.y())), true);
         break;
     }
+    case EventId::pointer_drag_stop:
+        if (m_kinetic_enabled)
+            m_kinetic.release();
+        break;
     default:
         break;
     }
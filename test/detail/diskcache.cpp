@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/diskcache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+class DiskCacheTest : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        char dir[] = "/tmp/egt_disk_cache_XXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+        m_dir = dir;
+        m_cache.directory(m_dir);
+        ASSERT_TRUE(m_cache.enabled());
+    }
+
+    void TearDown() override
+    {
+        const auto cmd = "rm -rf " + m_dir;
+        ASSERT_EQ(std::system(cmd.c_str()), 0);
+    }
+
+    static egt::shared_cairo_surface_t surface(uint32_t color)
+    {
+        egt::shared_cairo_surface_t s(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 16, 8),
+                                      cairo_surface_destroy);
+        cairo_surface_flush(s.get());
+        const auto data = cairo_image_surface_get_data(s.get());
+        const auto stride = cairo_image_surface_get_stride(s.get());
+        for (auto y = 0; y < 8; ++y)
+            for (auto x = 0; x < 16; ++x)
+                reinterpret_cast<uint32_t*>(data + y * stride)[x] = color + x + y * 16;
+        cairo_surface_mark_dirty(s.get());
+        return s;
+    }
+
+    static uint32_t pixel(const egt::shared_cairo_surface_t& s, int x, int y)
+    {
+        const auto data = cairo_image_surface_get_data(s.get());
+        const auto stride = cairo_image_surface_get_stride(s.get());
+        return reinterpret_cast<const uint32_t*>(data + y * stride)[x];
+    }
+
+    static std::string cache_file(const std::string& dir, uint64_t key)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.cache", static_cast<unsigned long long>(key));
+        return dir + "/" + name;
+    }
+
+    std::string m_dir;
+    egt::detail::DiskCache m_cache;
+};
+
+TEST_F(DiskCacheTest, StoreLoad)
+{
+    EXPECT_FALSE(m_cache.load(1));
+
+    m_cache.store(1, surface(0xff000000));
+
+    auto loaded = m_cache.load(1);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(cairo_image_surface_get_format(loaded.get()), CAIRO_FORMAT_ARGB32);
+    EXPECT_EQ(cairo_image_surface_get_width(loaded.get()), 16);
+    EXPECT_EQ(cairo_image_surface_get_height(loaded.get()), 8);
+    EXPECT_EQ(pixel(loaded, 0, 0), 0xff000000U);
+    EXPECT_EQ(pixel(loaded, 15, 7), 0xff000000U + 15 + 7 * 16);
+
+    EXPECT_FALSE(m_cache.load(2));
+
+    // a corrupt file is a miss
+    {
+        std::ofstream out(cache_file(m_dir, 2), std::ios::binary);
+        out << "not a cache file";
+    }
+    EXPECT_FALSE(m_cache.load(2));
+}
+
+TEST_F(DiskCacheTest, Invalidate)
+{
+    const auto file = m_dir + "/image.png";
+    {
+        std::ofstream out(file, std::ios::binary);
+        out << "image";
+    }
+
+    const auto h1 = egt::detail::DiskCache::source_hash("file://" + file);
+    EXPECT_NE(h1, 0U);
+    EXPECT_EQ(egt::detail::DiskCache::source_hash("file://" + file), h1);
+    m_cache.store(h1, surface(0xff000000));
+
+    // a new modification time is a new source
+    struct stat st {};
+    ASSERT_EQ(stat(file.c_str(), &st), 0);
+    struct utimbuf times {st.st_atime, st.st_mtime + 10};
+    ASSERT_EQ(utime(file.c_str(), &times), 0);
+
+    const auto h2 = egt::detail::DiskCache::source_hash("file://" + file);
+    EXPECT_NE(h2, h1);
+    EXPECT_FALSE(m_cache.load(h2));
+
+    EXPECT_EQ(egt::detail::DiskCache::source_hash("file://" + file + ".missing"), 0U);
+}
+
+TEST_F(DiskCacheTest, SizeLimit)
+{
+    m_cache.store(1, surface(0xff000000));
+    m_cache.store(2, surface(0xff100000));
+
+    // make the first file the least recently used
+    struct utimbuf times {1000, 1000};
+    ASSERT_EQ(utime(cache_file(m_dir, 1).c_str(), &times), 0);
+
+    struct stat st {};
+    ASSERT_EQ(stat(cache_file(m_dir, 2).c_str(), &st), 0);
+    const auto size = static_cast<size_t>(st.st_size);
+
+    m_cache.size_limit(size + size / 2);
+    EXPECT_FALSE(m_cache.load(1));
+    EXPECT_TRUE(m_cache.load(2));
+
+    m_cache.size_limit(0);
+    EXPECT_FALSE(m_cache.load(2));
+}
+
+TEST_F(DiskCacheTest, TrackSize)
+{
+    EXPECT_EQ(m_cache.size(), 0U);
+
+    m_cache.store(1, surface(0xff000000));
+    struct stat st {};
+    ASSERT_EQ(stat(cache_file(m_dir, 1).c_str(), &st), 0);
+    const auto size = static_cast<size_t>(st.st_size);
+    EXPECT_EQ(m_cache.size(), size);
+
+    // replacing a file does not count it twice
+    m_cache.store(1, surface(0xff100000));
+    EXPECT_EQ(m_cache.size(), size);
+
+    m_cache.store(2, surface(0xff200000));
+    EXPECT_EQ(m_cache.size(), 2 * size);
+
+    // going over the limit removes the least recently used file
+    m_cache.size_limit(2 * size);
+    struct utimbuf times {1000, 1000};
+    ASSERT_EQ(utime(cache_file(m_dir, 1).c_str(), &times), 0);
+    m_cache.store(3, surface(0xff300000));
+    EXPECT_EQ(m_cache.size(), 2 * size);
+    EXPECT_FALSE(m_cache.load(1));
+    EXPECT_TRUE(m_cache.load(2));
+    EXPECT_TRUE(m_cache.load(3));
+}
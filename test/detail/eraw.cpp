@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/erawimage.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using egt::detail::ErawImage;
+
+static std::string encode(std::vector<uint32_t>& pixels, uint32_t width, uint32_t height)
+{
+    std::ostringstream o;
+    ErawImage::save(o, reinterpret_cast<unsigned char*>(pixels.data()), width, height);
+    return o.str();
+}
+
+static std::vector<uint32_t> test_pixels(uint32_t width, uint32_t height)
+{
+    std::vector<uint32_t> pixels(width * height);
+    for (size_t i = 0; i < pixels.size(); ++i)
+    {
+        // runs on the top half, no two neighbors alike on the bottom half
+        if (i < pixels.size() / 2)
+            pixels[i] = 0xff000000 | static_cast<uint32_t>(i / 37);
+        else
+            pixels[i] = 0x80000000 | static_cast<uint32_t>(i * 2654435761U & 0xffffff);
+    }
+    return pixels;
+}
+
+TEST(Eraw, RoundTrip)
+{
+    const uint32_t width = 61;
+    const uint32_t height = 47;
+    auto pixels = test_pixels(width, height);
+    const auto data = encode(pixels, width, height);
+
+    auto surface = ErawImage::load(reinterpret_cast<const unsigned char*>(data.data()),
+                                   data.size());
+    ASSERT_TRUE(surface);
+    ASSERT_EQ(cairo_image_surface_get_width(surface.get()), static_cast<int>(width));
+    ASSERT_EQ(cairo_image_surface_get_height(surface.get()), static_cast<int>(height));
+
+    const auto stride = cairo_image_surface_get_stride(surface.get());
+    const auto out = cairo_image_surface_get_data(surface.get());
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        const auto row = reinterpret_cast<const uint32_t*>(out + y * stride);
+        for (uint32_t x = 0; x < width; ++x)
+            ASSERT_EQ(row[x], pixels[y * width + x]);
+    }
+}
+
+TEST(Eraw, LongRun)
+{
+    // more than one run block of 0x7fff pixels
+    const uint32_t width = 400;
+    const uint32_t height = 200;
+    std::vector<uint32_t> pixels(width * height, 0xff123456);
+    const auto data = encode(pixels, width, height);
+
+    auto surface = ErawImage::load(reinterpret_cast<const unsigned char*>(data.data()),
+                                   data.size());
+    ASSERT_TRUE(surface);
+    const auto out = reinterpret_cast<const uint32_t*>(cairo_image_surface_get_data(surface.get()));
+    EXPECT_EQ(out[0], 0xff123456);
+    EXPECT_EQ(out[width * height - 1], 0xff123456);
+}
+
+TEST(Eraw, Truncated)
+{
+    const uint32_t width = 32;
+    const uint32_t height = 32;
+    auto pixels = test_pixels(width, height);
+    const auto data = encode(pixels, width, height);
+    const auto buf = reinterpret_cast<const unsigned char*>(data.data());
+
+    EXPECT_FALSE(ErawImage::load(buf, 0));
+    EXPECT_FALSE(ErawImage::load(buf, ErawImage::header_size() - 1));
+    EXPECT_FALSE(ErawImage::load(buf, ErawImage::header_size()));
+    EXPECT_FALSE(ErawImage::load(buf, data.size() - 1));
+
+    auto bad = data;
+    bad[0] ^= 0xff;
+    EXPECT_FALSE(ErawImage::load(reinterpret_cast<const unsigned char*>(bad.data()),
+                                 bad.size()));
+}
+
+TEST(Eraw, DecodeBounds)
+{
+    std::vector<uint32_t> image(4);
+
+    // a run longer than the image
+    const std::vector<uint8_t> run = {0x05, 0x80, 0x11, 0x22, 0x33, 0x44};
+    EXPECT_FALSE(ErawImage::decode(run.data(), run.data() + run.size(),
+                                   image.data(), image.data() + image.size()));
+
+    // a literal block longer than the image
+    std::vector<uint8_t> literal = {0x05, 0x00};
+    literal.resize(literal.size() + 5 * sizeof(uint32_t));
+    EXPECT_FALSE(ErawImage::decode(literal.data(), literal.data() + literal.size(),
+                                   image.data(), image.data() + image.size()));
+
+    // a literal block longer than the stream
+    const std::vector<uint8_t> short_literal = {0x02, 0x00, 0x11, 0x22, 0x33, 0x44};
+    EXPECT_FALSE(ErawImage::decode(short_literal.data(),
+                                   short_literal.data() + short_literal.size(),
+                                   image.data(), image.data() + image.size()));
+
+    // a run missing its value
+    const std::vector<uint8_t> no_value = {0x04, 0x80, 0x11};
+    EXPECT_FALSE(ErawImage::decode(no_value.data(), no_value.data() + no_value.size(),
+                                   image.data(), image.data() + image.size()));
+
+    // exactly the image
+    const std::vector<uint8_t> exact = {0x04, 0x80, 0x11, 0x22, 0x33, 0x44};
+    EXPECT_TRUE(ErawImage::decode(exact.data(), exact.data() + exact.size(),
+                                  image.data(), image.data() + image.size()));
+    EXPECT_EQ(image[3], 0x44332211U);
+}
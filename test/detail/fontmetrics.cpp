@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/fontmetrics.h"
+#include <egt/ui>
+#include <gtest/gtest.h>
+
+TEST(FontMetrics, NullFont)
+{
+    auto& metrics = egt::detail::FontMetrics::get(nullptr);
+    EXPECT_EQ(metrics.font_extents().height, 0);
+    EXPECT_FALSE(metrics.glyph('a').simple);
+
+    const auto te = metrics.text_extents("abc");
+    EXPECT_EQ(te.width, 0);
+    EXPECT_EQ(te.x_advance, 0);
+}
+
+TEST(FontMetrics, Measure)
+{
+    egt::Application app;
+    egt::Font font(20);
+
+    auto& metrics = egt::detail::FontMetrics::get(font.scaled_font());
+    EXPECT_EQ(&metrics, &egt::detail::FontMetrics::get(font.scaled_font()));
+    EXPECT_GT(metrics.font_extents().height, 0);
+    EXPECT_GT(metrics.text_extents("abc").x_advance, 0);
+}
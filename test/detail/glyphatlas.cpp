@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/glyphatlas.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+using egt::detail::GlyphAtlas;
+
+/// Draw glyphs on a new surface with the atlas.
+static egt::shared_cairo_surface_t draw(cairo_scaled_font_t* font,
+                                        const std::vector<cairo_glyph_t>& glyphs)
+{
+    egt::shared_cairo_surface_t surface(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 300, 200),
+                                        cairo_surface_destroy);
+    auto cr = cairo_create(surface.get());
+    cairo_set_scaled_font(cr, font);
+    cairo_set_source_rgb(cr, 1, 1, 1);
+    EXPECT_TRUE(GlyphAtlas::show_glyphs(cr, glyphs.data(), glyphs.size()));
+    cairo_destroy(cr);
+    cairo_surface_flush(surface.get());
+    return surface;
+}
+
+static bool same_pixels(const egt::shared_cairo_surface_t& lhs,
+                        const egt::shared_cairo_surface_t& rhs)
+{
+    const auto stride = cairo_image_surface_get_stride(lhs.get());
+    const auto height = cairo_image_surface_get_height(lhs.get());
+    return !memcmp(cairo_image_surface_get_data(lhs.get()),
+                   cairo_image_surface_get_data(rhs.get()),
+                   static_cast<size_t>(stride) * height);
+}
+
+TEST(GlyphAtlas, PageReset)
+{
+    // disabled with EGT_NO_GLYPH_ATLAS
+    if (!GlyphAtlas::enabled())
+        return;
+
+    egt::shared_cairo_surface_t scratch(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1),
+                                        cairo_surface_destroy);
+    auto cr = cairo_create(scratch.get());
+    cairo_select_font_face(cr, "sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    // an odd size, so no other test shares the atlas
+    cairo_set_font_size(cr, 117);
+    auto font = cairo_scaled_font_reference(cairo_get_scaled_font(cr));
+    cairo_destroy(cr);
+
+    const std::string text = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    cairo_glyph_t* glyphs = nullptr;
+    int count = 0;
+    ASSERT_EQ(cairo_scaled_font_text_to_glyphs(font, 0, 0, text.data(), text.size(),
+              &glyphs, &count, nullptr, nullptr, nullptr),
+              CAIRO_STATUS_SUCCESS);
+
+    const std::vector<cairo_glyph_t> first = {{glyphs[0].index, 20, 150}};
+    const auto before = draw(font, first);
+    EXPECT_EQ(GlyphAtlas::page_count(font), 1U);
+
+    // every glyph at every subpixel offset is more than the pages can hold
+    size_t last = GlyphAtlas::page_count(font);
+    bool reset = false;
+    for (auto subpixel = 0; subpixel < GlyphAtlas::SUBPIXEL_X; ++subpixel)
+    {
+        for (auto i = 0; i < count; ++i)
+        {
+            const double x = 20 + static_cast<double>(subpixel) / GlyphAtlas::SUBPIXEL_X;
+            draw(font, {{glyphs[i].index, x, 150}});
+
+            const auto pages = GlyphAtlas::page_count(font);
+            EXPECT_LE(pages, GlyphAtlas::MAX_PAGES);
+            if (pages < last)
+                reset = true;
+            last = pages;
+        }
+    }
+    EXPECT_TRUE(reset);
+
+    // glyphs are rasterized again after a reset, the same as before
+    EXPECT_TRUE(same_pixels(before, draw(font, first)));
+
+    cairo_glyph_free(glyphs);
+    cairo_scaled_font_destroy(font);
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "detail/respack.h"
+#include <algorithm>
+#include <cstdio>
+#include <egt/resource.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace respack = egt::detail::respack;
+
+/// Pattern the compressed entries inflate to.
+static std::vector<unsigned char> pattern(int step)
+{
+    std::vector<unsigned char> data;
+    for (auto i = 0; i < 1000; ++i)
+        data.push_back((i * step) % 26 + 'a');
+    return data;
+}
+
+/// zlib compressed pattern(7).
+static const std::vector<unsigned char> compressed_a =
+{
+    0x78, 0xda, 0x4b, 0xcc, 0xc8, 0x2f, 0x4b, 0xce, 0x2a, 0xac, 0x48, 0xcd,
+    0x29, 0xae, 0x4a, 0xcf, 0x2b, 0x4d, 0xca, 0x2c, 0x28, 0x4f, 0xc9, 0x2e,
+    0xaa, 0x4c, 0xcb, 0x2d, 0x49, 0x1c, 0x95, 0x19, 0x95, 0x19, 0x95, 0x19,
+    0x26, 0x32, 0x00, 0x4d, 0xba, 0xab, 0xcc
+};
+
+/// zlib compressed pattern(11).
+static const std::vector<unsigned char> compressed_b =
+{
+    0x78, 0xda, 0x4b, 0xcc, 0x29, 0xcf, 0x28, 0x4e, 0xc9, 0xaf, 0xca, 0x2e,
+    0x4b, 0x2f, 0x4a, 0xce, 0xab, 0xcc, 0x2a, 0x4d, 0x2b, 0x4c, 0xca, 0xad,
+    0xc8, 0x2c, 0x49, 0x2d, 0x48, 0x1c, 0x95, 0x19, 0x95, 0x19, 0x95, 0x19,
+    0x26, 0x32, 0x00, 0x6d, 0x02, 0xab, 0xd0
+};
+
+struct PackItem
+{
+    std::string name;
+    std::vector<unsigned char> data;
+    uint32_t flags;
+    uint32_t raw_size;
+};
+
+/// Write a resource pack the way tools/respack does.
+static std::string write_pack(std::vector<PackItem> items)
+{
+    std::sort(items.begin(), items.end(), [](const PackItem & lhs, const PackItem & rhs)
+    {
+        respack::PackEntry entry{};
+        entry.hash = respack::hash(rhs.name.data(), rhs.name.size());
+        entry.name_len = rhs.name.size();
+        return respack::compare(respack::hash(lhs.name.data(), lhs.name.size()),
+                                lhs.name.data(), lhs.name.size(),
+                                entry, rhs.name.data()) < 0;
+    });
+
+    std::vector<respack::PackEntry> entries(items.size());
+    std::string names;
+    std::string data;
+    const auto names_offset = sizeof(respack::PackHeader) +
+                              entries.size() * sizeof(respack::PackEntry);
+    for (const auto& item : items)
+        names += item.name;
+    for (size_t x = 0, name = 0; x < items.size(); ++x)
+    {
+        auto& entry = entries[x];
+        entry.hash = respack::hash(items[x].name.data(), items[x].name.size());
+        entry.flags = items[x].flags;
+        entry.name_offset = names_offset + name;
+        entry.name_len = items[x].name.size();
+        entry.offset = names_offset + names.size() + data.size();
+        entry.size = items[x].data.size();
+        entry.raw_size = items[x].raw_size;
+        name += items[x].name.size();
+        data.append(items[x].data.begin(), items[x].data.end());
+    }
+
+    respack::PackHeader header{respack::MAGIC, respack::VERSION,
+                               static_cast<uint32_t>(entries.size()), 0};
+
+    const auto path = "/tmp/egt_test_" + std::to_string(getpid()) + ".pack";
+    std::ofstream out(path, std::ios_base::binary);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              entries.size() * sizeof(respack::PackEntry));
+    out << names << data;
+    return path;
+}
+
+class ResourcePack : public ::testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        const std::string text = "raw resource";
+        m_path = write_pack(
+        {
+            {"raw.txt", {text.begin(), text.end()}, 0, 0},
+            {"a.txt", compressed_a, respack::FLAG_ZLIB, 1000},
+            {"b.txt", compressed_b, respack::FLAG_ZLIB, 1000},
+        });
+        egt::ResourceManager::instance().add_pack(m_path);
+        m_limit = egt::ResourceManager::instance().cache_limit();
+    }
+
+    void TearDown() override
+    {
+        egt::ResourceManager::instance().clear();
+        egt::ResourceManager::instance().cache_limit(m_limit);
+        std::remove(m_path.c_str());
+    }
+
+    std::string m_path;
+    size_t m_limit{0};
+};
+
+TEST_F(ResourcePack, Lookup)
+{
+    auto& rm = egt::ResourceManager::instance();
+
+    EXPECT_TRUE(rm.exists("raw.txt"));
+    EXPECT_TRUE(rm.exists("a.txt"));
+    EXPECT_TRUE(rm.exists("b.txt"));
+    EXPECT_FALSE(rm.exists("c.txt"));
+    EXPECT_FALSE(rm.exists("raw.tx"));
+    EXPECT_EQ(rm.data("c.txt"), nullptr);
+
+    const std::string text = "raw resource";
+    ASSERT_EQ(rm.size("raw.txt"), text.size());
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(rm.data("raw.txt")),
+                          rm.size("raw.txt")), text);
+
+    auto names = rm.list();
+    EXPECT_NE(std::find(names.begin(), names.end(), "a.txt"), names.end());
+    EXPECT_NE(std::find(names.begin(), names.end(), "b.txt"), names.end());
+}
+
+TEST_F(ResourcePack, Compressed)
+{
+    auto& rm = egt::ResourceManager::instance();
+
+    EXPECT_FALSE(rm.compressed("raw.txt"));
+    EXPECT_TRUE(rm.compressed("a.txt"));
+    EXPECT_FALSE(rm.compressed("c.txt"));
+
+    // the inflated size is known without inflating
+    EXPECT_EQ(rm.size("b.txt"), 1000U);
+    EXPECT_EQ(rm.cache_size(), 1000U);
+
+    const auto expected = pattern(11);
+    std::vector<unsigned char> buf(expected.size());
+    ASSERT_TRUE(rm.read("b.txt", buf.data(), buf.size()));
+    EXPECT_EQ(buf, expected);
+    EXPECT_EQ(rm.cache_size(), 2000U);
+
+    rm.evict();
+    EXPECT_EQ(rm.cache_size(), 0U);
+}
+
+TEST_F(ResourcePack, CacheLimit)
+{
+    auto& rm = egt::ResourceManager::instance();
+    rm.cache_limit(1500);
+
+    const auto a = pattern(7);
+    const auto b = pattern(11);
+
+    auto data = rm.data("a.txt");
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), data));
+    EXPECT_EQ(rm.cache_size(), 1000U);
+
+    // inflating b evicts a, the least recently used
+    data = rm.data("b.txt");
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), data));
+    EXPECT_EQ(rm.cache_size(), 1000U);
+
+    // a is inflated again
+    data = rm.data("a.txt");
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), data));
+    EXPECT_EQ(rm.cache_size(), 1000U);
+
+    // lowering the limit drops everything over it
+    rm.cache_limit(10);
+    EXPECT_EQ(rm.cache_size(), 0U);
+
+    // the resource just inflated is kept even over the limit
+    data = rm.data("b.txt");
+    ASSERT_NE(data, nullptr);
+    EXPECT_TRUE(std::equal(b.begin(), b.end(), data));
+    EXPECT_EQ(rm.cache_size(), 1000U);
+}
+
+TEST(Resource, BadPack)
+{
+    const auto path = "/tmp/egt_test_bad_" + std::to_string(getpid()) + ".pack";
+    {
+        std::ofstream out(path, std::ios_base::binary);
+        out << "this is not a resource pack";
+    }
+
+    EXPECT_THROW(egt::ResourceManager::instance().add_pack(path), std::runtime_error);
+    EXPECT_THROW(egt::ResourceManager::instance().add_pack(path + ".missing"),
+                 std::runtime_error);
+    std::remove(path.c_str());
+}
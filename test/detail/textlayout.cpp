@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <egt/ui>
+#include <egt/detail/textlayout.h>
+#include <gtest/gtest.h>
+
+TEST(TextLayout, LeadingNewline)
+{
+    egt::Application app;
+
+    egt::detail::TextLayout layout;
+    layout.update(egt::Size(200, 200), "\nabc", egt::Font(), true, false,
+                  egt::AlignFlag::left | egt::AlignFlag::top,
+                  egt::Justification::start);
+
+    ASSERT_EQ(layout.glyph_count(), 4U);
+    const auto height = layout.glyph_cell(0).height();
+    EXPECT_GT(height, 0);
+
+    // the line break is on the first line, the text on the second
+    EXPECT_FLOAT_EQ(layout.glyph_cell(0).y(), 0);
+    for (size_t x = 1; x < layout.glyph_count(); ++x)
+    {
+        EXPECT_FLOAT_EQ(layout.glyph_cell(x).y(), height);
+        EXPECT_FLOAT_EQ(layout.glyph_cursor(x).y(), layout.glyph_cell(x).y());
+    }
+}
+
+TEST(TextLayout, ImageTop)
+{
+    egt::Application app;
+
+    const egt::Size image(40, 40);
+    egt::detail::TextLayout layout;
+    layout.update(egt::Size(200, 200), "abc", egt::Font(), false, false,
+                  egt::AlignFlag::left | egt::AlignFlag::top,
+                  egt::Justification::start,
+                  egt::AlignFlag::top, image);
+
+    // the text is on the line right below the image
+    EXPECT_EQ(layout.image_point().y(), 0);
+    ASSERT_EQ(layout.glyph_count(), 3U);
+    for (size_t x = 0; x < layout.glyph_count(); ++x)
+    {
+        EXPECT_FLOAT_EQ(layout.glyph_cell(x).y(), image.height());
+        EXPECT_FLOAT_EQ(layout.glyph_cursor(x).y(), layout.glyph_cell(x).y());
+    }
+}
@@ -3,6 +3,7 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <egt/detail/image.h>
 #include <egt/ui>
 #include <gtest/gtest.h>
 #include <memory>
@@ -190,6 +191,55 @@ TEST(Canvas, Basic)
     EXPECT_EQ(canvas4.format(), egt::PixelFormat::rgb565);
 }
 
+TEST(Painter, DrawPendingPath)
+{
+    auto red = egt::shared_cairo_surface_t(cairo_image_surface_create(CAIRO_FORMAT_RGB24, 10, 10),
+                                           cairo_surface_destroy);
+    {
+        auto cr = egt::shared_cairo_t(cairo_create(red.get()), cairo_destroy);
+        cairo_set_source_rgb(cr.get(), 1, 0, 0);
+        cairo_paint(cr.get());
+    }
+    egt::detail::mark_opaque(red.get(), true);
+    egt::Image image(red);
+    ASSERT_TRUE(image.opaque());
+
+    auto target = egt::shared_cairo_surface_t(cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 20, 20),
+                                              cairo_surface_destroy);
+    egt::Painter painter(egt::shared_cairo_t(cairo_create(target.get()), cairo_destroy));
+    auto cr = painter.context().get();
+
+    const auto pixel = [&target](int x, int y)
+    {
+        cairo_surface_flush(target.get());
+        auto data = cairo_image_surface_get_data(target.get());
+        const auto stride = cairo_image_surface_get_stride(target.get());
+        return *reinterpret_cast<const uint32_t*>(data + y * stride + x * 4);
+    };
+
+    const auto green = [&]()
+    {
+        cairo_set_source_rgb(cr, 0, 1, 0);
+        cairo_paint(cr);
+    };
+
+    // a subpath outside of the image is left as is
+    green();
+    cairo_rectangle(cr, 15, 15, 3, 3);
+    cairo_move_to(cr, 0, 0);
+    painter.draw(egt::Rect(0, 0, 10, 10), image);
+    EXPECT_EQ(pixel(5, 5), 0xffff0000u);
+    EXPECT_EQ(pixel(16, 16), 0xff00ff00u);
+
+    green();
+    cairo_rectangle(cr, 15, 15, 3, 3);
+    cairo_move_to(cr, 0, 0);
+    painter.draw(image);
+    EXPECT_EQ(pixel(5, 5), 0xffff0000u);
+    EXPECT_EQ(pixel(16, 16), 0xff00ff00u);
+    cairo_new_path(cr);
+}
+
 TEST(Geometry, Basic)
 {
     egt::Point p1(3, 4);
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <egt/ui>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(ConsoleTest, AppendLines)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto console = std::make_shared<egt::Console>(egt::Rect(0, 0, 200, 100), 3);
+    win.add(console);
+    EXPECT_EQ(console->max_lines(), 3U);
+
+    console->append("one\ntwo\n");
+    EXPECT_EQ(console->line_count(), 0U);
+    console->flush();
+    EXPECT_EQ(console->line_count(), 2U);
+    EXPECT_EQ(console->line(0), "one");
+    EXPECT_EQ(console->line(1), "two");
+
+    console->append("three");
+    console->append("four");
+    console->flush();
+    EXPECT_EQ(console->line_count(), 3U);
+    EXPECT_EQ(console->line(0), "two");
+    EXPECT_EQ(console->line(2), "four");
+
+    console->autoscroll(false);
+    console->append("five");
+    console->flush();
+    EXPECT_EQ(console->scroll_offset(), 1U);
+
+    console->max_lines(5);
+    EXPECT_EQ(console->line_count(), 3U);
+    EXPECT_EQ(console->line(0), "three");
+
+    console->clear();
+    EXPECT_EQ(console->line_count(), 0U);
+}
+
+TEST(ConsoleTest, AppendFromThread)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto console = std::make_shared<egt::Console>(egt::Rect(0, 0, 200, 100), 100);
+    win.add(console);
+
+    std::thread producer([console]()
+    {
+        for (auto x = 0; x < 1000; ++x)
+            console->append(std::to_string(x));
+    });
+    producer.join();
+
+    console->flush();
+    EXPECT_EQ(console->line_count(), 100U);
+    EXPECT_EQ(console->line(99), "999");
+}
@@ -64,3 +64,153 @@ TEST_P(FrameTest, TestWidget)
 }
 
 INSTANTIATE_TEST_SUITE_P(FrameTestGroup, FrameTest, testing::Values(1, 2, 4));
+
+namespace
+{
+
+/// Screen with only a composition buffer, where each row has its own color.
+class TestScreen : public egt::Screen
+{
+public:
+    explicit TestScreen(const egt::Size& size)
+    {
+        init(size);
+
+        auto data = cairo_image_surface_get_data(m_surface.get());
+        const auto stride = cairo_image_surface_get_stride(m_surface.get());
+        for (auto y = 0; y < size.height(); ++y)
+            for (auto x = 0; x < size.width(); ++x)
+                *reinterpret_cast<uint32_t*>(data + y * stride + x * 4) = row(y);
+        cairo_surface_mark_dirty(m_surface.get());
+    }
+
+    void schedule_flip() override {}
+
+    /// Color the row @b y starts with.
+    static uint32_t row(int y)
+    {
+        return 0xff000000u | static_cast<uint32_t>(y);
+    }
+
+    uint32_t pixel(int x, int y) const
+    {
+        cairo_surface_flush(m_surface.get());
+        auto data = cairo_image_surface_get_data(m_surface.get());
+        const auto stride = cairo_image_surface_get_stride(m_surface.get());
+        return *reinterpret_cast<const uint32_t*>(data + y * stride + x * 4);
+    }
+};
+
+/// Frame that can be given a screen, with its damage exposed.
+class ScrollFrame : public egt::Frame
+{
+public:
+    explicit ScrollFrame(const egt::Rect& rect, egt::Screen* screen = nullptr)
+        : egt::Frame(rect),
+          m_test_screen(screen)
+    {}
+
+    using egt::Frame::scroll_damage;
+
+    egt::Screen* screen() const override
+    {
+        return m_test_screen ? m_test_screen : egt::Frame::screen();
+    }
+
+    bool has_screen() const override { return m_test_screen != nullptr; }
+
+    const egt::Screen::DamageArray& damage_array() const { return m_damage; }
+
+    void clear_damage() { m_damage.clear(); }
+
+private:
+    egt::Screen* m_test_screen;
+};
+
+}
+
+TEST(ScreenTest, Scroll)
+{
+    TestScreen screen(egt::Size(100, 100));
+
+    EXPECT_TRUE(screen.scroll(egt::Rect(10, 10, 50, 50), egt::Point(0, -10)));
+    EXPECT_EQ(screen.pixel(20, 10), TestScreen::row(20));
+    EXPECT_EQ(screen.pixel(20, 49), TestScreen::row(59));
+    // the uncovered strip is left as is
+    EXPECT_EQ(screen.pixel(20, 55), TestScreen::row(55));
+    // nothing outside of the rectangle moves
+    EXPECT_EQ(screen.pixel(5, 10), TestScreen::row(10));
+    EXPECT_EQ(screen.pixel(20, 60), TestScreen::row(60));
+
+    EXPECT_TRUE(screen.scroll(egt::Rect(10, 10, 50, 50), egt::Point(0, 10)));
+    EXPECT_EQ(screen.pixel(20, 20), TestScreen::row(20));
+    EXPECT_EQ(screen.pixel(20, 59), TestScreen::row(59));
+    EXPECT_EQ(screen.pixel(20, 9), TestScreen::row(9));
+}
+
+TEST(ScreenTest, ScrollDamage)
+{
+    egt::Application app;
+    TestScreen screen(egt::Size(100, 100));
+    ScrollFrame top(egt::Rect(0, 0, 100, 100), &screen);
+    top.fill_flags(egt::Theme::FillFlag::solid);
+    top.clear_damage();
+
+    EXPECT_TRUE(top.scroll_damage(egt::Rect(0, 0, 100, 100), egt::Point(0, -10)));
+    EXPECT_EQ(screen.pixel(50, 0), TestScreen::row(10));
+    EXPECT_EQ(screen.pixel(50, 89), TestScreen::row(99));
+
+    // only the uncovered strip is damaged
+    ASSERT_EQ(top.damage_array().size(), 1U);
+    EXPECT_EQ(top.damage_array()[0], egt::Rect(0, 90, 100, 10));
+}
+
+TEST(ScreenTest, ScrollDamageCovered)
+{
+    egt::Application app;
+    TestScreen screen(egt::Size(100, 100));
+    ScrollFrame top(egt::Rect(0, 0, 100, 100), &screen);
+    top.fill_flags(egt::Theme::FillFlag::solid);
+
+    auto inner = std::make_shared<ScrollFrame>(egt::Rect(0, 0, 100, 100));
+    top.add(inner);
+    auto above = std::make_shared<egt::Frame>(egt::Rect(0, 40, 100, 20));
+    top.add(above);
+    top.clear_damage();
+
+    // a widget on top means the caller has to damage everything
+    EXPECT_FALSE(inner->scroll_damage(egt::Rect(0, 0, 100, 100), egt::Point(0, -10)));
+    EXPECT_EQ(screen.pixel(50, 0), TestScreen::row(0));
+    EXPECT_TRUE(top.damage_array().empty());
+
+    above->hide();
+    top.clear_damage();
+
+    EXPECT_TRUE(inner->scroll_damage(egt::Rect(0, 0, 100, 100), egt::Point(0, -10)));
+    EXPECT_EQ(screen.pixel(50, 0), TestScreen::row(10));
+    ASSERT_EQ(top.damage_array().size(), 1U);
+    EXPECT_EQ(top.damage_array()[0], egt::Rect(0, 90, 100, 10));
+}
+
+TEST(ScreenTest, ScrollDamageFromChild)
+{
+    egt::Application app;
+    TestScreen screen(egt::Size(100, 100));
+    ScrollFrame top(egt::Rect(0, 0, 100, 100), &screen);
+    top.fill_flags(egt::Theme::FillFlag::solid);
+
+    auto child = std::make_shared<egt::Label>("", egt::Rect(10, 10, 50, 50));
+    top.add(child);
+    top.clear_damage();
+
+    EXPECT_TRUE(top.scroll_damage_from_child(*child, child->box(), egt::Point(0, -10)));
+    EXPECT_EQ(screen.pixel(20, 10), TestScreen::row(20));
+    ASSERT_EQ(top.damage_array().size(), 1U);
+    EXPECT_EQ(top.damage_array()[0], egt::Rect(10, 50, 50, 10));
+
+    // translucent children can not be moved
+    child->alpha(0.5);
+    top.clear_damage();
+    EXPECT_FALSE(top.scroll_damage_from_child(*child, child->box(), egt::Point(0, -10)));
+    EXPECT_TRUE(top.damage_array().empty());
+}
@@ -72,3 +72,56 @@ TEST_P(ListBoxWidgetTest, TestWidget)
 }
 
 INSTANTIATE_TEST_SUITE_P(ListBoxWidgetTestGroup, ListBoxWidgetTest, Range(0, 4));
+
+TEST(ListViewTest, RecycleRows)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    std::vector<size_t> bound;
+    auto list = std::make_shared<egt::ListView>(egt::Rect(0, 0, 200, 400), 50000,
+                [&bound](size_t row, egt::StringItem & item)
+    {
+        item.text("Row " + std::to_string(row));
+        bound.push_back(row);
+    });
+    list->border(0);
+    list->padding(0);
+    list->margin(0);
+    win.add(list);
+
+    // a pool sized by the view, not by the number of rows
+    const auto pool = list->pool_size();
+    EXPECT_LT(pool, 20U);
+    EXPECT_EQ(list->row_count(), 50000U);
+    EXPECT_EQ(list->offset_max(), 50000 * egt::ListView::DEFAULT_ROW_HEIGHT - 400);
+
+    EXPECT_EQ(list->row_at(egt::Point(10, 5)), 0);
+    EXPECT_EQ(list->row_at(egt::Point(10, 85)), 2);
+
+    // scrolling by one row binds only one more row
+    list->offset(100 * egt::ListView::DEFAULT_ROW_HEIGHT);
+    bound.clear();
+    list->offset(101 * egt::ListView::DEFAULT_ROW_HEIGHT);
+    EXPECT_EQ(bound.size(), 1U);
+    EXPECT_EQ(list->row_at(egt::Point(10, 5)), 101);
+
+    list->scroll_bottom();
+    EXPECT_EQ(list->offset(), list->offset_max());
+    EXPECT_EQ(list->row_at(egt::Point(10, 399)), 49999);
+    EXPECT_EQ(list->pool_size(), pool);
+
+    bool changed = false;
+    list->on_selected_changed([&changed]()
+    {
+        changed = true;
+    });
+    list->selected(49998);
+    EXPECT_EQ(list->selected(), 49998);
+    EXPECT_TRUE(changed);
+
+    list->row_count(5);
+    EXPECT_EQ(list->offset(), 0);
+    EXPECT_EQ(list->selected(), -1);
+    EXPECT_EQ(list->row_at(egt::Point(10, 399)), -1);
+}
@@ -639,3 +639,89 @@ TEST_P(NoteBookTest, TestWidget)
 }
 
 INSTANTIATE_TEST_SUITE_P(NoteBookTestGroup, NoteBookTest, Range(0, 2));
+
+TEST(NotebookTest, LazyPages)
+{
+    egt::Application app;
+    egt::TopWindow win;
+    auto notebook = std::make_shared<egt::Notebook>(egt::Rect(0, 0, 200, 200));
+    win.add(notebook);
+
+    std::vector<int> built(4);
+    for (size_t x = 0; x < built.size(); ++x)
+    {
+        EXPECT_EQ(notebook->add_page([&built, x]()
+        {
+            ++built[x];
+            return std::make_shared<egt::NotebookTab>();
+        }), x);
+    }
+
+    // only the first page, which is selected, is built
+    EXPECT_EQ(notebook->page_count(), 4U);
+    EXPECT_EQ(notebook->count_children(), 1U);
+    EXPECT_EQ(built, std::vector<int>({1, 0, 0, 0}));
+    EXPECT_EQ(notebook->get(2), nullptr);
+
+    notebook->selected(2);
+    EXPECT_NE(notebook->get(2), nullptr);
+    EXPECT_TRUE(notebook->get(2)->visible());
+    EXPECT_FALSE(notebook->get(0)->visible());
+
+    // keep one page besides the selected one, dropping the oldest
+    notebook->selected(3);
+    notebook->page_budget(1);
+    EXPECT_EQ(notebook->get(0), nullptr);
+    // pages are removed from the event loop
+    app.event().poll();
+    EXPECT_EQ(notebook->count_children(), 2U);
+    EXPECT_EQ(notebook->get(0), nullptr);
+    EXPECT_NE(notebook->get(2), nullptr);
+
+    notebook->selected(size_t{0});
+    EXPECT_EQ(built, std::vector<int>({2, 0, 1, 1}));
+    EXPECT_EQ(notebook->get(2), nullptr);
+    EXPECT_NE(notebook->get(3), nullptr);
+    app.event().poll();
+    EXPECT_EQ(notebook->count_children(), 2U);
+}
+
+TEST(NotebookTest, SwitchFromPage)
+{
+    egt::Application app;
+    egt::TopWindow win;
+    auto notebook = std::make_shared<egt::Notebook>(egt::Rect(0, 0, 200, 200));
+    win.add(notebook);
+
+    std::weak_ptr<egt::NotebookTab> first;
+    std::shared_ptr<egt::Button> button;
+    notebook->add_page([&]()
+    {
+        auto tab = std::make_shared<egt::NotebookTab>();
+        button = std::make_shared<egt::Button>("Next");
+        button->on_click([notebook = notebook.get()](egt::Event&)
+        {
+            notebook->selected(1);
+        });
+        tab->add(button);
+        first = tab;
+        return tab;
+    });
+    notebook->add_page([]()
+    {
+        return std::make_shared<egt::NotebookTab>();
+    });
+    notebook->page_budget(0);
+
+    // the page switched away from is still alive while its button handles the click
+    egt::Event event(egt::EventId::pointer_click);
+    button->handle(event);
+    EXPECT_EQ(notebook->selected(), 1);
+    EXPECT_EQ(notebook->get(0), nullptr);
+    EXPECT_FALSE(first.expired());
+
+    button.reset();
+    app.event().poll();
+    EXPECT_TRUE(first.expired());
+    EXPECT_EQ(notebook->count_children(), 1U);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <egt/ui>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(ProducerTest, ChartFromThread)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+    const auto series = chart->add_uniform_series(egt::Palette::red, 0.0, 0.001);
+
+    egt::ChartProducer producer(*chart, series, 1000);
+    EXPECT_THROW(producer.push(1.0, 1.0), std::runtime_error);
+
+    std::thread thread([&producer]()
+    {
+        for (auto x = 0; x < 1500; ++x)
+            producer.push(x);
+    });
+    thread.join();
+
+    // nothing is taken while the event loop does not run
+    EXPECT_EQ(chart->size(series), 0U);
+    producer.flush();
+    EXPECT_EQ(chart->size(series), 1024U);
+    EXPECT_EQ(producer.dropped(), 1500U - 1024U);
+    EXPECT_EQ(chart->sample(series, 1023).second, 1023);
+}
+
+TEST(ProducerTest, LatestValueWins)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto slider = std::make_shared<egt::Slider>(egt::Rect(0, 0, 200, 40), 0, 1000);
+    win.add(slider);
+
+    egt::ValueProducer<int> producer(*slider);
+    std::thread thread([&producer]()
+    {
+        for (auto x = 0; x <= 100; ++x)
+            producer.push(x);
+    });
+    thread.join();
+
+    producer.flush();
+    EXPECT_EQ(slider->value(), 100);
+    EXPECT_EQ(producer.dropped(), 100U);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <cmath>
+#include <egt/ui>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(StreamChartTest, RingBuffer)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+
+    EXPECT_EQ(chart->add_series(egt::Palette::red, 10), 0U);
+    EXPECT_EQ(chart->add_series(egt::Palette::blue), 1U);
+    EXPECT_EQ(chart->series_count(), 2U);
+    EXPECT_EQ(chart->capacity(1), egt::StreamChart::DEFAULT_CAPACITY);
+
+    for (auto x = 0; x < 25; ++x)
+        chart->append(0, x, x * 2);
+
+    EXPECT_EQ(chart->size(0), 10U);
+    EXPECT_EQ(chart->size(1), 0U);
+    EXPECT_EQ(chart->sample(0, 0).first, 15);
+    EXPECT_EQ(chart->sample(0, 9).second, 48);
+
+    chart->capacity(0, 4);
+    EXPECT_EQ(chart->size(0), 4U);
+    EXPECT_EQ(chart->sample(0, 0).first, 21);
+
+    chart->clear();
+    EXPECT_EQ(chart->size(0), 0U);
+
+    EXPECT_THROW(chart->x_span(0), std::runtime_error);
+    EXPECT_THROW(chart->y_range(1, 1), std::runtime_error);
+    chart->y_range(-1, 1);
+    EXPECT_FALSE(chart->y_auto_range());
+    chart->y_auto();
+    EXPECT_TRUE(chart->y_auto_range());
+}
+
+TEST(StreamChartTest, DrawManySamples)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+    chart->x_span(1.0);
+    const auto series = chart->add_series(egt::Palette::red, 100000);
+
+    // 10 seconds at 10 kHz, more than the chart keeps or shows
+    for (auto x = 0; x < 100000; ++x)
+        chart->append(series, x / 10000., std::sin(x / 100.));
+
+    EXPECT_EQ(chart->size(series), 100000U);
+    EXPECT_FALSE(chart->plot_area().empty());
+
+    auto surface = egt::shared_cairo_surface_t(
+                       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 300, 200),
+                       cairo_surface_destroy);
+    egt::Painter painter(egt::shared_cairo_t(cairo_create(surface.get()), cairo_destroy));
+    chart->draw(painter, chart->box());
+
+    // after the columns are built, appending keeps them up to date
+    for (auto x = 100000; x < 110000; ++x)
+        chart->append(series, x / 10000., std::sin(x / 100.));
+    chart->draw(painter, chart->box());
+}
+
+TEST(StreamChartTest, Incremental)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+    chart->x_span(1.0);
+    chart->incremental(true);
+    EXPECT_TRUE(chart->incremental());
+    const auto series = chart->add_series(egt::Palette::red);
+
+    auto surface = egt::shared_cairo_surface_t(
+                       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 300, 200),
+                       cairo_surface_destroy);
+    egt::Painter painter(egt::shared_cairo_t(cairo_create(surface.get()), cairo_destroy));
+
+    // draw once per 100 samples, so most frames only scroll
+    for (auto x = 0; x < 20000; ++x)
+    {
+        chart->append(series, x / 10000., std::sin(x / 100.));
+        if (x % 100 == 99)
+            chart->draw(painter, chart->box());
+    }
+
+    chart->line_width(3);
+    chart->draw(painter, chart->box());
+    chart->incremental(false);
+    chart->draw(painter, chart->box());
+}
+
+TEST(StreamChartTest, IncrementalProperties)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+    chart->incremental(true);
+    chart->border(0);
+    chart->fill_flags(egt::Theme::FillFlag::solid);
+    chart->color(egt::Palette::ColorId::bg, egt::Palette::red);
+
+    auto surface = egt::shared_cairo_surface_t(
+                       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 300, 200),
+                       cairo_surface_destroy);
+    egt::Painter painter(egt::shared_cairo_t(cairo_create(surface.get()), cairo_destroy));
+
+    // a pixel of the padding, left of the labels
+    const auto pixel = [&surface]()
+    {
+        cairo_surface_flush(surface.get());
+        auto data = cairo_image_surface_get_data(surface.get());
+        const auto stride = cairo_image_surface_get_stride(surface.get());
+        return *reinterpret_cast<const uint32_t*>(data + 100 * stride + 2 * 4);
+    };
+
+    chart->draw(painter, chart->box());
+    EXPECT_EQ(pixel(), 0xffff0000u);
+
+    // the background image is drawn again when the palette changes
+    chart->color(egt::Palette::ColorId::bg, egt::Palette::blue);
+    chart->draw(painter, chart->box());
+    EXPECT_EQ(pixel(), 0xff0000ffu);
+}
+
+TEST(StreamChartTest, AppendArrays)
+{
+    egt::detail::RingBuffer<double> ring(5);
+    const float values[] = {1, 2, 3, 4, 5, 6, 7};
+    ring.append(values, 3);
+    ring.append(values + 3, 4);
+    EXPECT_EQ(ring.size(), 5U);
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), 7);
+
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto chart = std::make_shared<egt::StreamChart>(egt::Rect(0, 0, 300, 200));
+    win.add(chart);
+
+    const auto uniform = chart->add_uniform_series(egt::Palette::red, 10.0, 0.5, 4,
+                         egt::StreamChart::SampleFormat::float32);
+    chart->append(uniform, values, 7);
+    EXPECT_EQ(chart->size(uniform), 4U);
+    EXPECT_EQ(chart->sample(uniform, 0), std::make_pair(11.5, 4.0));
+    EXPECT_EQ(chart->sample(uniform, 3), std::make_pair(13.0, 7.0));
+    EXPECT_THROW(chart->append(uniform, 1.0, 1.0), std::runtime_error);
+
+    const auto series = chart->add_series(egt::Palette::blue, 10);
+    const double x[] = {1, 2, 3};
+    const double y[] = {4, 5, 6};
+    chart->append(series, x, y, 3);
+    EXPECT_EQ(chart->sample(series, 2), std::make_pair(3.0, 6.0));
+    EXPECT_THROW(chart->append(series, y, 3), std::runtime_error);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <egt/ui>
+#include <gtest/gtest.h>
+#include <set>
+
+TEST(TableViewTest, CellAt)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto table = std::make_shared<egt::TableView>(egt::Rect(0, 0, 300, 200), 1000, 4);
+    table->border(0);
+    table->padding(0);
+    table->margin(0);
+    win.add(table);
+    table->row_height(20);
+    table->column_width(1, 50);
+
+    // the header row takes the first 20 pixels
+    EXPECT_EQ(table->cell_at(egt::Point(10, 10)), std::make_pair(ssize_t(-1), ssize_t(0)));
+    EXPECT_EQ(table->cell_at(egt::Point(10, 25)), std::make_pair(ssize_t(0), ssize_t(0)));
+    EXPECT_EQ(table->cell_at(egt::Point(120, 65)), std::make_pair(ssize_t(2), ssize_t(1)));
+    EXPECT_EQ(table->cell_at(egt::Point(160, 65)), std::make_pair(ssize_t(2), ssize_t(2)));
+    EXPECT_EQ(table->cell_rect(2, 2), egt::Rect(150, 60, 100, 20));
+
+    EXPECT_EQ(table->offset_max(), egt::Point(350 - 300, 1000 * 20 - 180));
+    table->offset(egt::Point(1000, 1000));
+    EXPECT_EQ(table->offset(), egt::Point(50, 1000));
+    EXPECT_EQ(table->cell_at(egt::Point(10, 25)), std::make_pair(ssize_t(50), ssize_t(0)));
+
+    table->scroll_to(0);
+    EXPECT_EQ(table->offset().y(), 0);
+
+    table->selected(5);
+    EXPECT_EQ(table->selected(), 5);
+    table->row_count(3);
+    EXPECT_EQ(table->selected(), -1);
+}
+
+TEST(TableViewTest, ColumnOutOfRange)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto table = std::make_shared<egt::TableView>(egt::Rect(0, 0, 300, 200), 10, 2);
+    win.add(table);
+
+    table->column_width(2, 50);
+    table->column_title(2, "none");
+    EXPECT_EQ(table->column_width(2), 0);
+    EXPECT_TRUE(table->column_title(2).empty());
+    EXPECT_TRUE(table->cell_rect(0, 2).empty());
+    table->cell_changed(0, 2);
+}
+
+TEST(TableViewTest, DrawVisibleCells)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto table = std::make_shared<egt::TableView>(egt::Rect(0, 0, 300, 200), 100000, 50);
+    table->border(0);
+    table->padding(0);
+    table->margin(0);
+    win.add(table);
+    table->row_height(20);
+
+    std::set<std::pair<size_t, size_t>> drawn;
+    table->cell_renderer([&drawn](egt::Painter&, const egt::Rect&, size_t row, size_t column)
+    {
+        drawn.emplace(row, column);
+    });
+
+    auto surface = egt::shared_cairo_surface_t(
+                       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 300, 200),
+                       cairo_surface_destroy);
+    egt::Painter painter(egt::shared_cairo_t(cairo_create(surface.get()), cairo_destroy));
+
+    // 9 rows below the header and 3 columns fit
+    table->draw(painter, table->box());
+    EXPECT_EQ(drawn.size(), 9U * 3U);
+    EXPECT_EQ(drawn.count(std::make_pair(8, 2)), 1U);
+
+    // only the damaged cell
+    drawn.clear();
+    table->draw(painter, egt::Rect(110, 45, 10, 10));
+    EXPECT_EQ(drawn.size(), 1U);
+    EXPECT_EQ(drawn.count(std::make_pair(1, 1)), 1U);
+
+    drawn.clear();
+    table->offset(egt::Point(150, 20 * 5000));
+    table->draw(painter, table->box());
+    EXPECT_EQ(drawn.count(std::make_pair(5000, 1)), 1U);
+    EXPECT_EQ(drawn.count(std::make_pair(5008, 4)), 1U);
+    EXPECT_EQ(drawn.count(std::make_pair(4999, 1)), 0U);
+}
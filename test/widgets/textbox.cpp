@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <egt/ui>
+#include <gtest/gtest.h>
+
+using ::testing::TestWithParam;
+using ::testing::Values;
+
+class TextBoxTest : public testing::TestWithParam<uint32_t>
+{};
+
+TEST_P(TextBoxTest, EditText)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    const auto flags = egt::TextBox::TextFlags(static_cast<egt::TextBox::TextFlag>(GetParam()));
+    auto text = std::make_shared<egt::TextBox>("Hello\nWörld", flags);
+    win.add(text);
+
+    EXPECT_EQ(text->text(), "Hello\nWörld");
+    EXPECT_EQ(text->len(), 11U);
+    EXPECT_EQ(text->cursor(), 11U);
+
+    bool text_changed = false;
+    text->on_text_changed([&]()
+    {
+        text_changed = true;
+    });
+
+    text->cursor_set(5);
+    EXPECT_EQ(text->insert(", big"), 5U);
+    EXPECT_EQ(text->text(), "Hello, big\nWörld");
+    EXPECT_EQ(text->cursor(), 10U);
+    EXPECT_TRUE(text_changed);
+
+    text->selection(11, 2);
+    EXPECT_EQ(text->selected_text(), "Wö");
+    text->selection_delete();
+    EXPECT_EQ(text->text(), "Hello, big\nrld");
+    EXPECT_EQ(text->cursor(), 11U);
+
+    text->selection(8, 100);
+    EXPECT_EQ(text->selection_length(), 6U);
+    text->selection_delete();
+    EXPECT_EQ(text->text(), "Hello, b");
+
+    text->append("\nend");
+    EXPECT_EQ(text->text(), "Hello, b\nend");
+    EXPECT_EQ(text->cursor(), text->len());
+
+    text->max_length(4);
+    EXPECT_EQ(text->text(), "Hell");
+    EXPECT_EQ(text->insert("o"), 0U);
+    text->max_length(0);
+
+    text->clear();
+    EXPECT_TRUE(text->text().empty());
+    EXPECT_EQ(text->cursor(), 0U);
+}
+
+TEST(TextBoxDocumentTest, LargeDocument)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    std::string content;
+    for (auto x = 0; x < 10000; ++x)
+        content += "key" + std::to_string(x) + " = value\n";
+
+    auto text = std::make_shared<egt::TextBox>(content,
+                egt::TextBox::TextFlags({egt::TextBox::TextFlag::large_document}));
+    win.add(text);
+    EXPECT_EQ(text->text(), content);
+
+    text->cursor_begin();
+    text->insert("# config\n");
+    text->cursor_end();
+    text->insert("last = 1");
+    EXPECT_EQ(text->text(), "# config\n" + content + "last = 1");
+
+    text->selection(0, 9);
+    text->selection_delete();
+    EXPECT_EQ(text->text(), content + "last = 1");
+}
+
+namespace
+{
+/// Text box that takes keys without a keyboard.
+class KeyTextBox : public egt::TextBox
+{
+public:
+    using egt::TextBox::TextBox;
+    using egt::TextBox::handle_key;
+};
+}
+
+TEST(TextBoxDocumentTest, CursorUpDown)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    auto text = std::make_shared<KeyTextBox>("one\nlonger line\nab",
+                egt::TextBox::TextFlags({egt::TextBox::TextFlag::large_document}));
+    win.add(text);
+
+    const auto up = egt::Key(egt::EKEY_UP);
+    const auto down = egt::Key(egt::EKEY_DOWN);
+
+    // the column is kept, but not past the end of a shorter line
+    text->cursor_set(8);
+    text->handle_key(up);
+    EXPECT_EQ(text->cursor(), 3U);
+    text->handle_key(down);
+    EXPECT_EQ(text->cursor(), 7U);
+    text->handle_key(down);
+    EXPECT_EQ(text->cursor(), 18U);
+    text->handle_key(down);
+    EXPECT_EQ(text->cursor(), 18U);
+    text->handle_key(up);
+    EXPECT_EQ(text->cursor(), 6U);
+
+    text->cursor_set(2);
+    text->handle_key(up);
+    EXPECT_EQ(text->cursor(), 2U);
+
+    // lines after an edit are still found after more edits elsewhere
+    text->cursor_set(4);
+    text->insert("new\n");
+    text->cursor_set(0);
+    text->insert("x");
+    text->cursor_set(9);
+    text->handle_key(down);
+    EXPECT_EQ(text->cursor(), 21U);
+}
+
+TEST(TextBoxDocumentTest, DrawDocument)
+{
+    egt::Application app;
+    egt::TopWindow win;
+
+    std::string content;
+    for (auto x = 0; x < 100; ++x)
+        content += "line " + std::to_string(x) + "\n";
+
+    auto text = std::make_shared<egt::TextBox>(content, egt::Rect(0, 0, 200, 100),
+                egt::AlignFlags(),
+                egt::TextBox::TextFlags({egt::TextBox::TextFlag::large_document}));
+    win.add(text);
+    text->border(0);
+    text->fill_flags(egt::Theme::FillFlags());
+    text->color(egt::Palette::ColorId::text_highlight, egt::Palette::red);
+
+    auto surface = egt::shared_cairo_surface_t(
+                       cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 200, 100),
+                       cairo_surface_destroy);
+
+    // count the pixels of the highlight
+    const auto highlighted = [&]()
+    {
+        {
+            auto cr = egt::shared_cairo_t(cairo_create(surface.get()), cairo_destroy);
+            cairo_set_operator(cr.get(), CAIRO_OPERATOR_CLEAR);
+            cairo_paint(cr.get());
+            egt::Painter painter(cr);
+            text->draw(painter, text->box());
+        }
+
+        cairo_surface_flush(surface.get());
+        auto data = cairo_image_surface_get_data(surface.get());
+        const auto stride = cairo_image_surface_get_stride(surface.get());
+        size_t count = 0;
+        for (auto y = 0; y < 100; ++y)
+            for (auto x = 0; x < 200; ++x)
+                if (*reinterpret_cast<const uint32_t*>(data + y * stride + x * 4) == 0xffff0000u)
+                    ++count;
+        return count;
+    };
+
+    text->selection(0, 4);
+
+    // the first line is in view with the cursor at the start
+    text->cursor_begin();
+    EXPECT_GT(highlighted(), 0U);
+
+    // and scrolled out of view to show the cursor at the end
+    text->cursor_end();
+    EXPECT_EQ(highlighted(), 0U);
+}
+
+INSTANTIATE_TEST_SUITE_P(TextBoxTestGroup, TextBoxTest, Values(0, 2, 16));
@@ -3,6 +3,8 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#include <algorithm>
+#include <egt/detail/kinetic.h>
 #include <egt/ui>
 #include <gtest/gtest.h>
 
@@ -76,3 +78,182 @@ TEST_P(ViewTest, TestWidget)
     }
 }
 INSTANTIATE_TEST_SUITE_P(ViewTestGroup, ViewTest, Combine(Range(0, 3), Range(0, 3)));
+
+TEST(KineticScrollerTest, Fling)
+{
+    egt::Application app;
+
+    egt::detail::KineticScroller kinetic;
+    kinetic.bounds(egt::PointF(-1000, -1000), egt::PointF());
+
+    // drags past the end move with resistance
+    kinetic.begin(egt::PointF());
+    EXPECT_EQ(kinetic.drag(egt::PointF(0, -100)), egt::PointF(0, -100));
+    EXPECT_EQ(kinetic.drag(egt::PointF(0, 100)), egt::PointF(0, 50));
+
+    // a still pointer inside the bounds does not fling
+    kinetic.begin(egt::PointF());
+    kinetic.drag(egt::PointF(0, -10));
+    kinetic.release();
+    EXPECT_FALSE(kinetic.active());
+
+    // past the end, it bounces back
+    kinetic.begin(egt::PointF());
+    kinetic.drag(egt::PointF(0, 100));
+    kinetic.release();
+    EXPECT_TRUE(kinetic.active());
+    kinetic.stop();
+    EXPECT_FALSE(kinetic.active());
+
+    kinetic.overscroll(false);
+    kinetic.begin(egt::PointF());
+    EXPECT_EQ(kinetic.drag(egt::PointF(0, 100)), egt::PointF());
+}
+
+namespace
+{
+
+/// Frame that collects damage as if it had a screen.
+class DamageFrame : public egt::Frame
+{
+public:
+    using egt::Frame::Frame;
+
+    bool has_screen() const override { return true; }
+
+    egt::Screen* screen() const override { return nullptr; }
+
+    const egt::Screen::DamageArray& damage_array() const { return m_damage; }
+
+    void clear_damage() { m_damage.clear(); }
+};
+
+/// ScrolledView with its tiles exposed.
+class TileView : public egt::ScrolledView
+{
+public:
+    using egt::ScrolledView::ScrolledView;
+
+    size_t tile_count() const { return m_tiles.size(); }
+
+    size_t max_tiles() const { return m_max_tiles; }
+
+    size_t dirty_tiles() const
+    {
+        return std::count_if(m_tiles.begin(), m_tiles.end(),
+                             [](const Tile & t) { return t.dirty; });
+    }
+
+    bool tile_dirty(const egt::Point& index) const
+    {
+        for (const auto& t : m_tiles)
+            if (t.index == index)
+                return t.dirty;
+        return false;
+    }
+};
+
+/// Widget that counts how many times it is drawn.
+class CountWidget : public egt::Widget
+{
+public:
+    using egt::Widget::Widget;
+
+    void draw(egt::Painter&, const egt::Rect&) override { ++draws; }
+
+    size_t draws{0};
+};
+
+class TileTest : public testing::Test
+{
+protected:
+
+    void SetUp() override
+    {
+        m_top = std::make_shared<DamageFrame>(egt::Rect(0, 0, 200, 200));
+        m_view = std::make_shared<TileView>(egt::Rect(0, 0, 200, 200),
+                                            egt::ScrolledView::Policy::never,
+                                            egt::ScrolledView::Policy::as_needed);
+        m_top->add(m_view);
+        // content many screens tall
+        m_child = std::make_shared<CountWidget>(egt::Rect(0, 0, 200, 4000));
+        m_view->add(m_child);
+
+        m_surface = egt::shared_cairo_surface_t(
+                        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 200, 200),
+                        cairo_surface_destroy);
+    }
+
+    void draw()
+    {
+        egt::Painter painter(egt::shared_cairo_t(cairo_create(m_surface.get()), cairo_destroy));
+        m_view->draw(painter, m_view->box());
+    }
+
+    egt::Application m_app;
+    std::shared_ptr<DamageFrame> m_top;
+    std::shared_ptr<TileView> m_view;
+    std::shared_ptr<CountWidget> m_child;
+    egt::shared_cairo_surface_t m_surface;
+};
+
+}
+
+TEST_F(TileTest, ChildDamage)
+{
+    draw();
+    ASSERT_GT(m_view->tile_count(), 1U);
+    EXPECT_EQ(m_view->dirty_tiles(), 0U);
+
+    m_child->damage(egt::Rect(10, 10, 20, 20));
+    EXPECT_EQ(m_view->dirty_tiles(), 1U);
+    EXPECT_TRUE(m_view->tile_dirty(egt::Point(0, 0)));
+}
+
+TEST_F(TileTest, DamageOutsideView)
+{
+    draw();
+    m_top->clear_damage();
+
+    // far below what is in view
+    m_child->damage(egt::Rect(0, 3000, 50, 50));
+    EXPECT_TRUE(m_top->damage_array().empty());
+
+    m_child->damage(egt::Rect(10, 10, 20, 20));
+    EXPECT_FALSE(m_top->damage_array().empty());
+}
+
+TEST_F(TileTest, TileLimit)
+{
+    const auto bottom = -m_view->offset_max().y();
+    ASSERT_GT(bottom, 1000);
+
+    for (auto y = 0; y <= bottom; y += 37)
+    {
+        m_view->offset(egt::Point(0, -y));
+        draw();
+        EXPECT_LE(m_view->tile_count(), m_view->max_tiles());
+    }
+}
+
+TEST_F(TileTest, OffsetKeepsCleanTiles)
+{
+    draw();
+    const auto draws = m_child->draws;
+    EXPECT_GT(draws, 0U);
+
+    // the same tiles are in view
+    m_view->offset(egt::Point(0, -10));
+    draw();
+    EXPECT_EQ(m_child->draws, draws);
+
+    // new tiles are rendered, the ones left are kept for coming back
+    m_view->offset(egt::Point(0, -300));
+    draw();
+    const auto scrolled = m_child->draws;
+    EXPECT_GT(scrolled, draws);
+
+    m_view->offset(egt::Point(0, 0));
+    draw();
+    EXPECT_EQ(m_child->draws, scrolled);
+}
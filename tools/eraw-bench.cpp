@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <chrono>
+#include <cxxopts.hpp>
+#include <erawimage.h>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+/*
+ * Compare eraw decode against PNG decode.
+ *
+ * Each input PNG is decoded once to get the reference pixels, encoded to eraw
+ * in memory, and then both formats are decoded repeatedly from memory.
+ *
+ *     ./eraw-bench ../icons/128px/\*.png
+ */
+
+struct PngStream
+{
+    const unsigned char* data;
+    size_t len;
+    size_t offset;
+};
+
+static cairo_status_t read_png_stream(void* closure, unsigned char* data, unsigned int length)
+{
+    auto stream = static_cast<PngStream*>(closure);
+    if (stream->offset + length > stream->len)
+        return CAIRO_STATUS_READ_ERROR;
+    memcpy(data, stream->data + stream->offset, length);
+    stream->offset += length;
+    return CAIRO_STATUS_SUCCESS;
+}
+
+template<class F>
+static double time_it(size_t iterations, F&& func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t x = 0; x < iterations; ++x)
+        func();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv)
+{
+    cxxopts::Options options("eraw-bench", "eraw vs png decode benchmark");
+    options.add_options()
+    ("h,help", "help")
+    ("n,iterations", "decode iterations per file",
+     cxxopts::value<size_t>()->default_value("100"))
+    ("positional", "PNG...", cxxopts::value<std::vector<std::string>>())
+    ;
+    options.positional_help("PNG...");
+
+    options.parse_positional({"positional"});
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help") || !result.count("positional"))
+    {
+        std::cout << options.help() << std::endl;
+        return result.count("help") ? 0 : 1;
+    }
+
+    const auto iterations = result["iterations"].as<size_t>();
+    auto& files = result["positional"].as<std::vector<std::string>>();
+
+    double png_total = 0;
+    double eraw_total = 0;
+    size_t png_bytes = 0;
+    size_t eraw_bytes = 0;
+
+    std::cout << std::left << std::setw(40) << "file"
+              << std::right << std::setw(10) << "png us"
+              << std::setw(10) << "eraw us"
+              << std::setw(10) << "speedup" << std::endl;
+
+    for (auto& file : files)
+    {
+        std::ifstream in(file, std::ios_base::binary);
+        const std::string png((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+        const auto png_data = reinterpret_cast<const unsigned char*>(png.data());
+
+        egt::unique_cairo_surface_t reference(cairo_image_surface_create_from_png(file.c_str()));
+        if (cairo_surface_status(reference.get()) != CAIRO_STATUS_SUCCESS)
+        {
+            std::cerr << "error: unable to open input " << file << std::endl;
+            continue;
+        }
+
+        cairo_surface_flush(reference.get());
+        std::ostringstream o;
+        egt::detail::ErawImage::save(o,
+                                     cairo_image_surface_get_data(reference.get()),
+                                     cairo_image_surface_get_width(reference.get()),
+                                     cairo_image_surface_get_height(reference.get()));
+        const auto eraw = o.str();
+        const auto eraw_data = reinterpret_cast<const unsigned char*>(eraw.data());
+
+        const auto png_time = time_it(iterations, [&]()
+        {
+            PngStream stream{png_data, png.size(), 0};
+            egt::unique_cairo_surface_t s(
+                cairo_image_surface_create_from_png_stream(read_png_stream, &stream));
+        });
+
+        const auto eraw_time = time_it(iterations, [&]()
+        {
+            auto s = egt::detail::ErawImage::load(eraw_data, eraw.size());
+        });
+
+        png_total += png_time;
+        eraw_total += eraw_time;
+        png_bytes += png.size();
+        eraw_bytes += eraw.size();
+
+        std::cout << std::left << std::setw(40) << file.substr(file.find_last_of('/') + 1)
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << png_time
+                  << std::setw(10) << eraw_time
+                  << std::setw(9) << (png_time / eraw_time) << "x" << std::endl;
+    }
+
+    std::cout << std::left << std::setw(40) << "total"
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << png_total
+              << std::setw(10) << eraw_total
+              << std::setw(9) << (eraw_total > 0 ? png_total / eraw_total : 0) << "x" << std::endl;
+    std::cout << "size: png " << png_bytes << " bytes, eraw " << eraw_bytes << " bytes" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2018 Microchip Technology Inc.  All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cxxopts.hpp>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <respack.h>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+/*
+ * Create an EGT resource pack from a list of files.
+ *
+ * Each file is registered under its file name, so "images/logo.png" can be
+ * loaded with the URI "res:logo.png" once the pack is added with
+ * ResourceManager::add_pack().
+ */
+
+using namespace egt::detail::respack;
+
+struct Item
+{
+    std::string name;
+    std::vector<unsigned char> data;
+    uint32_t raw_size;
+    uint32_t flags;
+    uint32_t hash;
+};
+
+static std::string basename(const std::string& path)
+{
+    const auto i = path.find_last_of('/');
+    return i == std::string::npos ? path : path.substr(i + 1);
+}
+
+int main(int argc, char** argv)
+{
+    cxxopts::Options options("respack", "EGT resource pack generator");
+    options.add_options()
+    ("h,help", "help")
+    ("z,compress", "zlib compress entries that get smaller")
+    ("o,output", "output pack file", cxxopts::value<std::string>())
+    ("positional", "INPUT...", cxxopts::value<std::vector<std::string>>())
+    ;
+    options.positional_help("INPUT...");
+
+    options.parse_positional({"positional"});
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help"))
+    {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+
+    if (!result.count("positional") || !result.count("output"))
+    {
+        std::cerr << options.help() << std::endl;
+        return 1;
+    }
+
+    const auto compress = result.count("compress") > 0;
+    std::vector<Item> items;
+
+    for (auto& path : result["positional"].as<std::vector<std::string>>())
+    {
+        std::ifstream in(path, std::ios_base::binary);
+        if (!in)
+        {
+            std::cerr << "error: unable to open input " << path << std::endl;
+            return 1;
+        }
+
+        Item item;
+        item.name = basename(path);
+        item.data.assign(std::istreambuf_iterator<char>(in),
+                         std::istreambuf_iterator<char>());
+        item.raw_size = item.data.size();
+        item.flags = 0;
+        item.hash = hash(item.name.data(), item.name.size());
+
+        if (compress && !item.data.empty())
+        {
+            auto len = compressBound(item.data.size());
+            std::vector<unsigned char> out(len);
+            if (compress2(out.data(), &len, item.data.data(), item.data.size(),
+                          Z_BEST_COMPRESSION) == Z_OK &&
+                len < item.data.size())
+            {
+                out.resize(len);
+                item.data = std::move(out);
+                item.flags |= FLAG_ZLIB;
+            }
+        }
+
+        items.emplace_back(std::move(item));
+    }
+
+    std::sort(items.begin(), items.end(), [](const Item & a, const Item & b)
+    {
+        PackEntry entry{};
+        entry.hash = b.hash;
+        entry.name_len = b.name.size();
+        return compare(a.hash, a.name.data(), a.name.size(), entry, b.name.data()) < 0;
+    });
+
+    auto dup = std::adjacent_find(items.begin(), items.end(), [](const Item & a, const Item & b)
+    {
+        return a.name == b.name;
+    });
+    if (dup != items.end())
+    {
+        std::cerr << "error: duplicate resource name " << dup->name << std::endl;
+        return 1;
+    }
+
+    PackHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.count = items.size();
+
+    std::vector<PackEntry> entries(items.size());
+    uint64_t offset = sizeof(PackHeader) + sizeof(PackEntry) * items.size();
+
+    for (size_t x = 0; x < items.size(); ++x)
+    {
+        entries[x].hash = items[x].hash;
+        entries[x].flags = items[x].flags;
+        entries[x].name_offset = offset;
+        entries[x].name_len = items[x].name.size();
+        offset += items[x].name.size();
+    }
+
+    for (size_t x = 0; x < items.size(); ++x)
+    {
+        // keep data word aligned for consumers that map it directly
+        offset = (offset + 3) & ~uint64_t(3);
+        entries[x].offset = offset;
+        entries[x].size = items[x].data.size();
+        entries[x].raw_size = items[x].raw_size;
+        offset += items[x].data.size();
+    }
+
+    const auto output = result["output"].as<std::string>();
+    std::ofstream o(output, std::ios_base::binary);
+    if (!o)
+    {
+        std::cerr << "error: unable to write to file " << output << std::endl;
+        return 1;
+    }
+
+    o.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    o.write(reinterpret_cast<const char*>(entries.data()), sizeof(PackEntry) * entries.size());
+    for (auto& item : items)
+        o.write(item.name.data(), item.name.size());
+    for (size_t x = 0; x < items.size(); ++x)
+    {
+        static const char pad[4] = {};
+        o.write(pad, entries[x].offset - o.tellp());
+        o.write(reinterpret_cast<const char*>(items[x].data.data()), items[x].data.size());
+    }
+
+    if (!o)
+    {
+        std::cerr << "error: unable to write to file " << output << std::endl;
+        return 1;
+    }
+
+    return 0;
+}